@@ -0,0 +1,348 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "problem.hpp"
+#include "flp_solver.hpp"
+#include "argument.hpp"
+#include "archive.hpp"
+#include "methods.hpp"
+#include "reader.hpp"
+#include "timer.hpp"
+#include "json.hpp"
+#include <getopt.h>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <ctime>
+#include <cstdlib>
+
+/*
+	Class: record
+
+	Measures of one method on one instance.
+*/
+struct record
+{
+	std::string instance;
+	std::string method;
+	std::string engine;    // cold, warm or reopt
+	int threads;
+	double build_time;     // Wall clock time to build the model
+	double wall_time;      // Wall clock time of the method
+	double cpu_time;       // CPU time of the method, all threads
+	solver_statistics statistics;
+	int front_size;
+};
+
+/*
+	Function: run
+
+	Run a method on an instance.
+
+	Parameters:
+		instance - An instance.
+		method - lexicographic, supported, efficient or relaxation.
+		threads - The number of threads.
+		rec - The measures.
+*/
+void run( const problem & instance, const std::string & method, int threads, record & rec );
+
+/*
+	Function: write_csv_string
+
+	Write a CSV field in quotes, doubling the quotes it contains.
+*/
+void write_csv_string( std::ostream & os, const std::string & value );
+
+/*
+	Function: write_csv
+
+	Parameters:
+		records - All the measures.
+		os - An output stream.
+*/
+void write_csv( const std::vector<record> & records, std::ostream & os );
+
+/*
+	Function: write_json
+
+	Parameters:
+		records - All the measures.
+		os - An output stream.
+*/
+void write_json( const std::vector<record> & records, std::ostream & os );
+
+/*
+	Function: usage
+
+	Parameters:
+		program_name - The executable name (use argv[0]).
+		os - An output stream.
+*/
+void usage( const char * program_name, std::ostream & os = std::cout );
+
+////////////////////////////////////////////////////////////////////////////////
+
+int main( int argc, char * argv[] )
+{
+	static int compare( 0 );
+	static const struct option long_options[] = {
+		{ "uncapacitated",    no_argument,       0,                       'u' },
+		{ "capacitated",      no_argument,       0,                       'c' },
+		{ "multi-source",     no_argument,       0,                       'm' },
+		{ "threads",          required_argument, 0,                       't' },
+		{ "warm-start",       no_argument,       &argument::warm_start,   1   },
+		{ "cold-start",       no_argument,       &argument::warm_start,   0   },
+		{ "reopt",            no_argument,       &argument::reopt,        1   },
+		{ "lazy-opening",     no_argument,       &argument::lazy_opening, 1   },
+		{ "compare-engines",  no_argument,       &compare,                1   },
+		{ "flp-heuristic",    no_argument,       &argument::heuristic,    1   },
+		{ "no-flp-heuristic", no_argument,       &argument::heuristic,    0   },
+		{ "format",           required_argument, 0,                       'F' },
+		{ "output",           required_argument, 0,                       'o' },
+		{ "help",             no_argument,       0,                       'h' },
+		{ 0, 0, 0, 0 }
+	};
+	static const char * const methods[] = { "lexicographic", "supported", "efficient", "relaxation" };
+
+	std::string format( "csv" ), output;
+	std::vector<record> records;
+	int threads( 1 ), next_option;
+
+	do
+	{
+		next_option = getopt_long( argc, argv, "ucmt:F:o:h", long_options, 0 );
+		switch ( next_option )
+		{
+			case 'u': argument::capacitated = 0; break;
+			case 'c': argument::capacitated = 1; break;
+			case 'm': argument::single_source = 0; break;
+			case 't': std::istringstream( optarg ) >> threads; break;
+			case 'F': format = optarg; break;
+			case 'o': output = optarg; break;
+			case 0: break;
+			case -1: break;
+
+			case 'h':
+			default:
+				usage( argv[0] );
+				return 0;
+		}
+	}
+	while ( next_option != -1 );
+
+	if ( optind >= argc || ( format != "csv" && format != "json" ) )
+	{
+		usage( argv[0] );
+		return 0;
+	}
+
+	// The methods read their options from the argument class
+	argument::verbose = 0;
+	argument::verblevel = 0;
+	argument::threads = threads < 1 ? 1 : threads;
+
+	// Warm start and reoptimization of each engine
+	std::vector< std::pair<int, int> > engines;
+
+	if ( compare )
+	{
+		engines.push_back( std::make_pair( 0, 0 ) );
+		engines.push_back( std::make_pair( 1, 0 ) );
+		engines.push_back( std::make_pair( 1, 1 ) );
+	}
+	else
+	{
+		engines.push_back( std::make_pair( argument::warm_start, argument::reopt ) );
+	}
+
+	for ( int index = optind; index < argc; ++index )
+	{
+		problem instance( (bool)argument::capacitated, (bool)argument::single_source );
+		mapped_file file;
+
+		try
+		{
+			load_instance( argv[index], file, instance );
+
+			for ( std::size_t k = 0; k < sizeof( methods ) / sizeof( methods[0] ); ++k )
+			{
+				for ( std::size_t e = 0; e < engines.size(); ++e )
+				{
+					record rec;
+					rec.instance = argv[index];
+					argument::warm_start = engines[e].first;
+					argument::reopt = engines[e].second;
+					run( instance, methods[k], argument::threads, rec );
+					records.push_back( rec );
+
+					std::clog << rec.instance << ' ' << rec.method << ' ' << rec.engine << ": "
+						<< rec.wall_time << "s" << std::endl;
+				}
+			}
+		}
+		catch ( const std::exception & e )
+		{
+			std::cerr << "Error: " << argv[index] << ": " << e.what() << std::endl;
+		}
+	}
+
+	// Write the results
+	std::ofstream file;
+	std::ostream & os = output.empty() ? std::cout : file;
+
+	if ( !output.empty() )
+	{
+		file.open( output.c_str() );
+		if ( !file )
+		{
+			std::cerr << "Error: cannot open " << output << std::endl;
+			return 0;
+		}
+	}
+
+	if ( format == "json" )
+		write_json( records, os );
+	else
+		write_csv( records, os );
+
+	return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void run( const problem & instance, const std::string & method, int threads, record & rec )
+{
+	archive pareto_front;
+	bool relaxation = ( method == "relaxation" );
+
+	argument::relaxation = relaxation;
+	argument::objective = 0;
+
+	// Same settings as the program
+	timer wall;
+	flp_solver solve( instance, relaxation, argument::lazy_opening );
+	solve.set_verblevel( argument::verblevel );
+	solve.set_warm_start( argument::warm_start );
+	solve.set_reoptimization( argument::reopt );
+	solve.set_dual_extraction( relaxation );
+	solve.set_heuristic( argument::heuristic );
+	rec.build_time = wall.elapsed();
+
+	std::clock_t cpu_start = std::clock();
+	wall.restart();
+
+	if ( method == "lexicographic" )
+		pareto_front = lexicographic( solve );
+	else if ( method == "efficient" )
+		pareto_front = threads > 1 ? parallel_epsilon_constraint( solve, threads, 0 ) : epsilon_constraint( solve );
+	else // supported or relaxation
+		pareto_front = threads > 1 ? parallel_dichotomic_method( solve, threads ) : dichotomic_method( solve );
+
+	rec.wall_time = wall.elapsed();
+	rec.cpu_time = ( std::clock() - cpu_start ) / (double)CLOCKS_PER_SEC;
+	rec.method = method;
+	rec.engine = argument::reopt ? "reopt" : argument::warm_start ? "warm" : "cold";
+	rec.threads = threads;
+	rec.statistics = solve.statistics();
+	rec.front_size = pareto_front.size();
+}
+
+void write_csv_string( std::ostream & os, const std::string & value )
+{
+	os << '"';
+	for ( std::size_t index = 0; index < value.size(); ++index )
+	{
+		if ( value[index] == '"' )
+			os << '"';
+		os << value[index];
+	}
+	os << '"';
+}
+
+void write_csv( const std::vector<record> & records, std::ostream & os )
+{
+	os << "instance,method,engine,threads,build_time,wall_time,cpu_time,solves,nodes,lp_iterations,front_size\n";
+
+	for ( std::size_t index = 0; index < records.size(); ++index )
+	{
+		const record & rec = records[index];
+		write_csv_string( os, rec.instance );
+		os
+			<< ',' << rec.method << ','
+			<< rec.engine << ','
+			<< rec.threads << ','
+			<< rec.build_time << ','
+			<< rec.wall_time << ','
+			<< rec.cpu_time << ','
+			<< rec.statistics.solves << ','
+			<< rec.statistics.nodes << ','
+			<< rec.statistics.lp_iterations << ','
+			<< rec.front_size << '\n';
+	}
+	os.flush();
+}
+
+void write_json( const std::vector<record> & records, std::ostream & os )
+{
+	os << "[\n";
+
+	for ( std::size_t index = 0; index < records.size(); ++index )
+	{
+		const record & rec = records[index];
+		os << "  { \"instance\": ";
+		write_json_string( os, rec.instance );
+		os << ", \"method\": ";
+		write_json_string( os, rec.method );
+		os << ", \"engine\": ";
+		write_json_string( os, rec.engine );
+		os
+			<< ", \"threads\": " << rec.threads
+			<< ", \"build_time\": " << rec.build_time
+			<< ", \"wall_time\": " << rec.wall_time
+			<< ", \"cpu_time\": " << rec.cpu_time
+			<< ", \"solves\": " << rec.statistics.solves
+			<< ", \"nodes\": " << rec.statistics.nodes
+			<< ", \"lp_iterations\": " << rec.statistics.lp_iterations
+			<< ", \"front_size\": " << rec.front_size
+			<< " }" << ( index + 1 < records.size() ? "," : "" ) << '\n';
+	}
+	os << "]\n";
+	os.flush();
+}
+
+void usage( const char * program_name, std::ostream & os )
+{
+	os
+		<< "Usage: " << program_name << " [OPTIONS] <instance>..." << std::endl
+		<< "Run every method on every instance and report the measures." << std::endl
+		<< "Options:" << std::endl
+		<< "\t-u,--uncapacitated     for uncapacitated facility location" << std::endl
+		<< "\t-c,--capacitated       for capacitated facility location"   << std::endl
+		<< "\t-m,--multi-source      for multi source facility location"  << std::endl
+		<< "\t-t,--threads <n>       number of threads"                   << std::endl
+		<< "\t   --cold-start        to disable warm start between solves" << std::endl
+		<< "\t   --reopt             to use SCIP reoptimization"           << std::endl
+		<< "\t   --compare-engines   to run each method cold, warm started" << std::endl
+		<< "\t                       and with SCIP reoptimization"        << std::endl
+		<< "\t   --lazy-opening      to separate x(i,j) <= y(j) on demand" << std::endl
+		<< "\t   --no-flp-heuristic  to disable the facility location heuristic" << std::endl
+		<< "\t-F,--format <f>        csv (default) or json"               << std::endl
+		<< "\t-o,--output <file>     output file (default: stdout)"       << std::endl
+		<< "\t-h,--help              to display this help"                << std::endl;
+}
@@ -0,0 +1,264 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ALIGNED_ARRAY_HPP
+#define ALIGNED_ARRAY_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <algorithm>
+#include <new>
+
+/*
+	Class: aligned_array
+
+	A fixed size array of plain data in one contiguous block, aligned on a
+	cache line. Elements are copied, never constructed nor destructed.
+*/
+template <typename T>
+class aligned_array
+{
+public:
+	// Alignment in bytes
+	enum { alignment = 64 };
+
+	/*
+		Constructor: aligned_array
+	*/
+	aligned_array();
+
+	/*
+		Constructor: aligned_array
+
+		Parameters:
+			size - Number of elements.
+			value - Initial value of the elements.
+	*/
+	explicit aligned_array( std::size_t size, const T & value = T() );
+
+	/*
+		Constructor: aligned_array
+	*/
+	aligned_array( const aligned_array & other );
+
+	/*
+		Destructor: aligned_array
+	*/
+	~aligned_array();
+
+	/*
+		Method: operator =
+	*/
+	aligned_array & operator = ( const aligned_array & other );
+
+	/*
+		Method: assign
+
+		Resize the array, all the elements being set to value.
+	*/
+	void assign( std::size_t size, const T & value = T() );
+
+	/*
+		Method: borrow
+
+		Refer to an external block of elements without copying it. The block
+		must outlive the array, which does not free it.
+	*/
+	void borrow( T * data, std::size_t size );
+
+	/*
+		Method: clear
+	*/
+	void clear();
+
+	/*
+		Method: is_borrowed
+	*/
+	bool is_borrowed() const;
+
+	/*
+		Method: swap
+	*/
+	void swap( aligned_array & other );
+
+	/*
+		Method: size
+	*/
+	std::size_t size() const;
+
+	/*
+		Method: empty
+	*/
+	bool empty() const;
+
+	/*
+		Method: data
+	*/
+	T * data();
+
+	/*
+		Method: data
+	*/
+	const T * data() const;
+
+	/*
+		Method: operator []
+	*/
+	T & operator [] ( std::size_t index );
+
+	/*
+		Method: operator []
+	*/
+	const T & operator [] ( std::size_t index ) const;
+
+private:
+	T * _data;
+	std::size_t _size;
+	bool _borrowed;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+aligned_array<T>::aligned_array() :
+	_data( 0 ),
+	_size( 0 ),
+	_borrowed( false )
+{
+}
+
+template <typename T>
+aligned_array<T>::aligned_array( std::size_t size, const T & value ) :
+	_data( 0 ),
+	_size( 0 ),
+	_borrowed( false )
+{
+	assign( size, value );
+}
+
+template <typename T>
+aligned_array<T>::aligned_array( const aligned_array & other ) :
+	_data( 0 ),
+	_size( 0 ),
+	_borrowed( false )
+{
+	*this = other;
+}
+
+template <typename T>
+aligned_array<T>::~aligned_array()
+{
+	clear();
+}
+
+template <typename T>
+aligned_array<T> & aligned_array<T>::operator = ( const aligned_array & other )
+{
+	if ( this != &other )
+	{
+		assign( other._size );
+		std::copy( other._data, other._data + other._size, _data );
+	}
+	return *this;
+}
+
+template <typename T>
+void aligned_array<T>::assign( std::size_t size, const T & value )
+{
+	if ( size != _size || _borrowed )
+	{
+		void * block( 0 );
+
+		clear();
+
+		if ( size > 0 && posix_memalign( &block, alignment, size * sizeof( T ) ) != 0 )
+			throw std::bad_alloc();
+
+		_data = static_cast<T *>( block );
+		_size = size;
+	}
+	std::fill( _data, _data + _size, value );
+}
+
+template <typename T>
+void aligned_array<T>::borrow( T * data, std::size_t size )
+{
+	clear();
+	_data = data;
+	_size = size;
+	_borrowed = true;
+}
+
+template <typename T>
+void aligned_array<T>::clear()
+{
+	if ( !_borrowed )
+		std::free( _data );
+	_data = 0;
+	_size = 0;
+	_borrowed = false;
+}
+
+template <typename T>
+void aligned_array<T>::swap( aligned_array & other )
+{
+	std::swap( _data, other._data );
+	std::swap( _size, other._size );
+	std::swap( _borrowed, other._borrowed );
+}
+
+template <typename T>
+inline bool aligned_array<T>::is_borrowed() const
+{
+	return _borrowed;
+}
+
+template <typename T>
+inline std::size_t aligned_array<T>::size() const
+{
+	return _size;
+}
+
+template <typename T>
+inline bool aligned_array<T>::empty() const
+{
+	return _size == 0;
+}
+
+template <typename T>
+inline T * aligned_array<T>::data()
+{
+	return _data;
+}
+
+template <typename T>
+inline const T * aligned_array<T>::data() const
+{
+	return _data;
+}
+
+template <typename T>
+inline T & aligned_array<T>::operator [] ( std::size_t index )
+{
+	return _data[index];
+}
+
+template <typename T>
+inline const T & aligned_array<T>::operator [] ( std::size_t index ) const
+{
+	return _data[index];
+}
+
+#endif
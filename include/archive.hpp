@@ -0,0 +1,179 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ARCHIVE_HPP
+#define ARCHIVE_HPP
+
+#include <vector>
+#include <cstddef>
+
+/*
+	Class: archive
+
+	A set of mutually nondominated points (minimization), stored in a flat
+	array and sorted in lexicographic order.
+
+	In the bi-objective case, the second objective is decreasing along the
+	array, so that checking the dominance of a point is a binary search.
+	With more objectives, a point can only be dominated by a point before
+	it and only dominate points after it, which limits the sweep.
+*/
+class archive
+{
+public:
+	/*
+		Constructor: archive
+
+		Parameters:
+			dimension - Number of objectives.
+	*/
+	explicit archive( int dimension = 2 );
+
+	/*
+		Method: insert
+
+		Insert a point unless it is weakly dominated by a point of the
+		archive, and remove the points it dominates.
+
+		Parameters:
+			z - A point.
+
+		Returns:
+			true if the point has been inserted, false otherwise.
+	*/
+	bool insert( const double * z );
+
+	/*
+		Method: insert
+	*/
+	bool insert( const std::vector<double> & z );
+
+	/*
+		Method: is_dominated
+
+		Return true if a point of the archive weakly dominates z.
+	*/
+	bool is_dominated( const double * z ) const;
+
+	/*
+		Method: is_dominated
+	*/
+	bool is_dominated( const std::vector<double> & z ) const;
+
+	/*
+		Method: clear
+	*/
+	void clear();
+
+	/*
+		Method: size
+	*/
+	int size() const;
+
+	/*
+		Method: empty
+	*/
+	bool empty() const;
+
+	/*
+		Method: dimension
+	*/
+	int dimension() const;
+
+	/*
+		Method: operator []
+
+		Return a pointer to the objectives of the index-th point.
+	*/
+	const double * operator [] ( int index ) const;
+
+	/*
+		Method: point
+
+		Copy the index-th point into a vector.
+	*/
+	void point( int index, std::vector<double> & z ) const;
+
+private:
+	int _dimension;
+	std::vector<double> _points;
+
+	/*
+		Method: lower_bound
+
+		Return the index of the first point not lexicographically less than z.
+	*/
+	int lower_bound( const double * z ) const;
+
+	/*
+		Method: upper_bound
+
+		Return the index of the first point lexicographically greater than z.
+	*/
+	int upper_bound( const double * z ) const;
+
+	/*
+		Method: dominates
+
+		Return true if a weakly dominates b.
+	*/
+	bool dominates( const double * a, const double * b ) const;
+
+	/*
+		Method: less
+
+		Return true if a is lexicographically less than b.
+	*/
+	bool less( const double * a, const double * b ) const;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline bool archive::insert( const std::vector<double> & z )
+{
+	return insert( &z[0] );
+}
+
+inline bool archive::is_dominated( const std::vector<double> & z ) const
+{
+	return is_dominated( &z[0] );
+}
+
+inline void archive::clear()
+{
+	_points.clear();
+}
+
+inline int archive::size() const
+{
+	return (int)( _points.size() / _dimension );
+}
+
+inline bool archive::empty() const
+{
+	return _points.empty();
+}
+
+inline int archive::dimension() const
+{
+	return _dimension;
+}
+
+inline const double * archive::operator [] ( int index ) const
+{
+	return &_points[(std::size_t)index * _dimension];
+}
+
+#endif
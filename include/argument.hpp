@@ -18,6 +18,7 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
 
 /*
 	Class: argument
@@ -58,34 +59,108 @@ struct argument
 	*/
 	static void usage( const char * program_name, std::ostream & os = std::cout );
 
+	/*
+		Function: identity
+
+		Returns:
+			The options which the points found depend on, to tell whether a
+			checkpoint belongs to the same run.
+	*/
+	static std::string identity();
+
+	/*
+		Function: method
+
+		Returns:
+			The selected method: lexicographic, weighted-sum, supported or
+			efficient.
+	*/
+	static std::string method();
+
 	// Integer or boolean parameters
 	static int
 		capacitated,
 		single_source,
 		relaxation,
+		lazy_opening,
 		lexicographic,
 		weighted_sum,
 		supported,
 		efficient,
 		objective,
+		objectives,
 		display_solution,
 		verblevel,
 		verbose,
+		threads,
+		slabs,
+		jobs,
+		serve,
+		node_limit,
+		warm_start,
+		reopt,
+		harvest,
+		heuristic,
+		lagrangian,
+		resume,
+		convert,
 		help;
 
 	// Floating point parameters
 	static double
 		lambda,
 		from,
-		step;
+		step,
+		augmented,
+		time_limit,
+		checkpoint_interval;
 
 	// Instance file name
 	static std::string filename;
 
+	// All the instance file names, several for the batch mode
+	static std::vector<std::string> filenames;
+
+	// Manifest of the batch mode, see read_manifest
+	static std::string batch_file;
+
+	// Socket of --serve, empty for stdin/stdout
+	static std::string serve_address;
+
+	// Format of --output, empty for the text output
+	static std::string output_format;
+
+	// Solution file name, see solution_store::write
+	static std::string solutions_file;
+
+	// Destination file name for --convert
+	static std::string destination;
+
+	// Trace file name, see trace_writer::open
+	static std::string trace_file;
+
+	// Checkpoint file name, see checkpoint
+	static std::string checkpoint_file;
+
 	// Identifiers
 	enum
 	{
-		id_step = 0x100
+		id_step = 0x100,
+		id_threads,
+		id_slabs,
+		id_trace,
+		id_time_limit,
+		id_node_limit,
+		id_augmented,
+		id_objectives,
+		id_checkpoint,
+		id_checkpoint_interval,
+		id_batch,
+		id_jobs,
+		id_serve,
+		id_output,
+		id_solutions,
+		id_lagrangian
 	};
 };
 
@@ -0,0 +1,70 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef BATCH_HPP
+#define BATCH_HPP
+
+#include "trace.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+
+/*
+	Class: batch_job
+
+	An instance to solve in batch mode, with its method.
+*/
+struct batch_job
+{
+	std::string filename;
+	std::string method;   // See argument::method
+
+	batch_job( const std::string & filename, const std::string & method ) :
+		filename( filename ), method( method ) {}
+};
+
+/*
+	Function: read_manifest
+
+	Read a manifest of jobs, one per line: an instance file name optionally
+	followed by a method (lexicographic, weighted-sum, supported or
+	efficient). Empty lines and lines starting with # are skipped. Throw
+	std::runtime_error on failure.
+
+	Parameters:
+		filename - The manifest file.
+		method - The method of the jobs without one.
+		jobs - The jobs to append to.
+*/
+void read_manifest( const std::string & filename, const std::string & method, std::vector<batch_job> & jobs );
+
+/*
+	Function: run_batch
+
+	Solve jobs in one process, several at a time, with the options of the
+	argument class. The result of each job is written as soon as it is
+	known, as one JSON line: instance, method, status ("complete", "error"
+	or the reason of an early stop), times, statistics and points. An
+	error does not stop the other jobs.
+
+	Parameters:
+		jobs - The jobs.
+		num_jobs - The number of jobs solved at a time.
+		trace - The trace of all solves, or 0.
+		os - An output stream.
+*/
+void run_batch( const std::vector<batch_job> & jobs, int num_jobs, trace_writer * trace, std::ostream & os );
+
+#endif
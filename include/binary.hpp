@@ -0,0 +1,94 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef BINARY_HPP
+#define BINARY_HPP
+
+#include "problem.hpp"
+#include "mapped_file.hpp"
+#include <string>
+#include <stdint.h>
+
+/*
+	Class: binary_header
+
+	Header of the binary instance format. It is followed by the arrays
+	below, in native byte order, each one starting on a 64 bytes boundary:
+
+	- assignment costs, p x m x n, objective-major (see problem::c)
+	- opening costs, p x n
+	- demands, m (capacitated instances only)
+	- capacities, n (capacitated instances only)
+
+	An instance read with --uncapacitated has no demands nor capacities,
+	so its binary file cannot be loaded with --capacitated.
+*/
+struct binary_header
+{
+	char     magic[8];          // "MOFLPBIN"
+	uint32_t version;           // Format version
+	uint32_t byte_order;        // byte_order_mark, written natively
+	uint32_t num_objectives;    // p
+	uint32_t num_customers;     // m
+	uint32_t num_facilities;    // n
+	uint32_t capacitated;       // 1 if demands and capacities are present
+	uint32_t cost_type;         // cost_double
+	uint32_t reserved[7];       // Zero, pads the header to 64 bytes
+
+	enum
+	{
+		current_version = 1,
+		byte_order_mark = 0x01020304,
+		cost_double = 0,
+		alignment = 64
+	};
+};
+
+/*
+	Function: is_binary_instance
+
+	Return true if a mapped file starts with the binary format magic.
+*/
+bool is_binary_instance( const mapped_file & file );
+
+/*
+	Function: map_binary_instance
+
+	Load a binary instance without copying the assignment costs: the
+	problem refers to the mapped file, which must outlive it. The small
+	opening cost, demand and capacity arrays are copied.
+
+	Parameters:
+		file - A mapped binary instance.
+		instance - The problem to fill; capacitated and num_objectives must
+		           be set beforehand and match the file.
+
+	Throws:
+		std::runtime_error if the file is not a valid binary instance, or if
+		its sizes are zero or do not fit in the file.
+*/
+void map_binary_instance( const mapped_file & file, problem & instance );
+
+/*
+	Function: write_binary_instance
+
+	Write a problem in the binary format.
+
+	Throws:
+		std::runtime_error if the file cannot be written.
+*/
+void write_binary_instance( const std::string & filename, const problem & instance );
+
+#endif
@@ -0,0 +1,114 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef BUDGET_HPP
+#define BUDGET_HPP
+
+#include "thread.hpp"
+#include <csignal>
+
+/*
+	Class: budget
+
+	A global time and node budget shared by all the solves of a method,
+	possibly from several threads. Each solve may use what is left of the
+	budget. The budget is also exhausted when SIGINT or SIGTERM is received,
+	once <catch_signals> has been called.
+*/
+class budget
+{
+public:
+	/*
+		Constructor: budget
+
+		Parameters:
+			time_limit - Wall clock time limit in seconds, infinity if none.
+			node_limit - Total number of nodes, negative if none.
+	*/
+	budget( double time_limit, long node_limit );
+
+	/*
+		Method: exhausted
+	*/
+	bool exhausted() const;
+
+	/*
+		Method: time_left
+
+		Returns:
+			The number of seconds left, infinity if there is no time limit.
+	*/
+	double time_left() const;
+
+	/*
+		Method: nodes_left
+
+		Returns:
+			The number of nodes left, negative if there is no node limit.
+	*/
+	long nodes_left() const;
+
+	/*
+		Method: consume_nodes
+	*/
+	void consume_nodes( long nodes );
+
+	/*
+		Method: reason
+
+		Returns:
+			"time limit", "node limit", "interrupted" or 0 if the budget is
+			not exhausted.
+	*/
+	const char * reason() const;
+
+	/*
+		Function: catch_signals
+
+		Catch SIGINT and SIGTERM so that the current solves stop and the
+		points found so far are kept.
+	*/
+	static void catch_signals();
+
+	/*
+		Function: signaled
+
+		Returns:
+			true if SIGINT or SIGTERM has been received.
+	*/
+	static bool signaled();
+
+private:
+	double _deadline;
+	long _nodes;          // Nodes left, negative if unlimited
+	mutable mutex _lock;  // Protect _nodes
+
+	static volatile std::sig_atomic_t _signaled;
+
+	static void handler( int signum );
+
+	// Non copyable
+	budget( const budget & );
+	budget & operator = ( const budget & );
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline bool budget::signaled()
+{
+	return _signaled != 0;
+}
+
+#endif
@@ -0,0 +1,99 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CANDIDATE_POOL_HPP
+#define CANDIDATE_POOL_HPP
+
+#include "archive.hpp"
+#include "thread.hpp"
+#include <vector>
+
+/*
+	Class: candidate_pool
+
+	The nondominated points of all the feasible solutions met by the solves,
+	including the ones which are not optimal for their scalarization. They
+	are not proven efficient, but give cutoffs to later solves and fill the
+	gaps of a front stopped early. Points can be added by several threads.
+*/
+class candidate_pool
+{
+public:
+	/*
+		Constructor: candidate_pool
+
+		Parameters:
+			dimension - Number of objectives.
+	*/
+	explicit candidate_pool( int dimension );
+
+	/*
+		Method: insert
+
+		Insert a point unless it is weakly dominated by a candidate.
+
+		Returns:
+			true if the point has been inserted, false otherwise.
+	*/
+	bool insert( const std::vector<double> & z );
+
+	/*
+		Method: best
+
+		Find the least weighted sum of the candidates which satisfy
+		lower <= z <= upper.
+
+		Parameters:
+			weights - The weight of each objective.
+			lower - Lower bound of each objective.
+			upper - Upper bound of each objective.
+			value - The weighted sum of the best candidate.
+
+		Returns:
+			true if a candidate satisfies the bounds, false otherwise.
+	*/
+	bool best( const std::vector<double> & weights, const std::vector<double> & lower,
+		const std::vector<double> & upper, double & value ) const;
+
+	/*
+		Method: merge
+
+		Insert the candidates into a front.
+
+		Returns:
+			The number of candidates inserted.
+	*/
+	int merge( archive & front ) const;
+
+	/*
+		Method: clear
+	*/
+	void clear();
+
+	/*
+		Method: size
+	*/
+	int size() const;
+
+private:
+	archive _candidates;
+	mutable mutex _lock;   // Protect _candidates
+
+	// Non copyable
+	candidate_pool( const candidate_pool & );
+	candidate_pool & operator = ( const candidate_pool & );
+};
+
+#endif
@@ -0,0 +1,151 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CHECKPOINT_HPP
+#define CHECKPOINT_HPP
+
+#include "problem.hpp"
+#include "archive.hpp"
+#include "timer.hpp"
+#include <string>
+#include <vector>
+
+/*
+	Class: checkpoint
+
+	State of a method saved to a file from time to time, so that a stopped
+	run can be resumed: the points found so far, some parameters and the
+	pending tasks (triangles, epsilon values, boxes...), whose meaning
+	depends on the method. The file also holds an identity string (instance
+	hash and options) which must match to resume.
+*/
+class checkpoint
+{
+public:
+	/*
+		Constructor: checkpoint
+
+		Parameters:
+			filename - The checkpoint file.
+			identity - Identity of the run, see <instance_hash>.
+			interval - Minimum number of seconds between two saves.
+	*/
+	checkpoint( const std::string & filename, const std::string & identity, double interval );
+
+	/*
+		Method: load
+
+		Read the checkpoint file. Throw std::runtime_error if the file is
+		invalid or belongs to another run.
+
+		Returns:
+			false if the file does not exist.
+	*/
+	bool load();
+
+	/*
+		Method: resumed
+
+		Returns:
+			true if a state has been loaded.
+	*/
+	bool resumed() const;
+
+	/*
+		Method: points
+	*/
+	const archive & points() const;
+
+	/*
+		Method: parameters
+	*/
+	const std::vector<double> & parameters() const;
+
+	/*
+		Method: tasks
+
+		Returns:
+			The pending tasks, empty if the method has finished.
+	*/
+	const std::vector< std::vector<double> > & tasks() const;
+
+	/*
+		Method: due
+
+		Returns:
+			true if the interval has elapsed since the last save.
+	*/
+	bool due() const;
+
+	/*
+		Method: save
+
+		Replace the checkpoint file atomically. Throw std::runtime_error on
+		failure.
+	*/
+	void save( const archive & points, const std::vector<double> & parameters,
+		const std::vector< std::vector<double> > & tasks );
+
+	/*
+		Function: instance_hash
+
+		Returns:
+			A FNV-1a hash of an instance, in hexadecimal.
+	*/
+	static std::string instance_hash( const problem & instance );
+
+private:
+	std::string _filename;
+	std::string _identity;
+	double _interval;
+	timer _clock;                 // Time since the last save
+	bool _resumed;
+	archive _points;
+	std::vector<double> _parameters;
+	std::vector< std::vector<double> > _tasks;
+
+	// Non copyable
+	checkpoint( const checkpoint & );
+	checkpoint & operator = ( const checkpoint & );
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline bool checkpoint::resumed() const
+{
+	return _resumed;
+}
+
+inline const archive & checkpoint::points() const
+{
+	return _points;
+}
+
+inline const std::vector<double> & checkpoint::parameters() const
+{
+	return _parameters;
+}
+
+inline const std::vector< std::vector<double> > & checkpoint::tasks() const
+{
+	return _tasks;
+}
+
+inline bool checkpoint::due() const
+{
+	return _clock.elapsed() >= _interval;
+}
+
+#endif
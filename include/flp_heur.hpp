@@ -0,0 +1,51 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef FLP_HEUR_HPP
+#define FLP_HEUR_HPP
+
+#include "problem.hpp"
+#include <scip/scip.h>
+#include <vector>
+
+/*
+	Function: include_flp_heur
+
+	Include a primal heuristic for facility location in SCIP. At the root
+	node, it opens facilities greedily, or starts from the facilities of the
+	incumbent, then improves them by drop and swap moves. Each set of open
+	facilities is completed by the cheapest assignment: in closed form
+	without capacities, else by a greedy repair filling the cheapest open
+	facilities first. Candidates are scored by the current scalarization,
+	the ones violating the capacities or epsilon constraints last.
+
+	The parameter heuristics/flp/maxevaluations limits the number of sets
+	of open facilities evaluated by a run.
+
+	Parameters:
+		scip - A SCIP instance.
+		instance - The problem.
+		vars - The n variables y(j) then the m*n variables x(i,j).
+		weights - The weight of each objective in the objective of SCIP.
+		lower - The lower bound of each objective.
+		upper - The upper bound of each objective.
+
+	The problem and vectors are not copied, they must outlive SCIP and are
+	read at each run.
+*/
+SCIP_RETCODE include_flp_heur( SCIP * scip, const problem & instance, SCIP_VAR ** vars,
+	const std::vector<double> * weights, const std::vector<double> * lower, const std::vector<double> * upper );
+
+#endif
@@ -17,9 +17,60 @@
 #define FLP_SOLVER_HPP
 
 #include "problem.hpp"
+#include "trace.hpp"
+#include "budget.hpp"
+#include "lower_bound_set.hpp"
+#include "solution_store.hpp"
+#include "candidate_pool.hpp"
 #include <scip/scip.h>
 #include <vector>
+#include <utility>
+#include <algorithm>
 #include <string>
+#include <limits>
+
+class flp_solver;
+
+/*
+	Class: point_observer
+
+	Notified of the points found by the methods (see methods.hpp), possibly
+	by several threads at once. The points may later turn out to be
+	dominated.
+*/
+class point_observer
+{
+public:
+	/*
+		Destructor: point_observer
+	*/
+	virtual ~point_observer() {}
+
+	/*
+		Method: found
+
+		Parameters:
+			solve - The solver, whose current solution gives the point.
+			z - The point.
+	*/
+	virtual void found( const flp_solver & solve, const std::vector<double> & z ) = 0;
+};
+
+/*
+	Class: solver_statistics
+
+	Counters accumulated over the solves of one or several flp_solver.
+*/
+struct solver_statistics
+{
+	int solves;           // Number of scalarizations solved
+	long nodes;           // Branch-and-bound nodes
+	long lp_iterations;   // LP iterations
+
+	solver_statistics() : solves( 0 ), nodes( 0 ), lp_iterations( 0 ) {}
+
+	solver_statistics & operator += ( const solver_statistics & other );
+};
 
 /*
 	Class: flp_solver
@@ -31,8 +82,17 @@ class flp_solver
 public:
 	/*
 		Constructor: flp_solver
+
+		Parameters:
+			instance - The problem to solve.
+			relaxation - Solve the linear relaxation.
+			lazy_opening - Replace the m*n rows x(i,j) <= y(j) by n aggregated
+				rows sum(i) x(i,j) <= m y(j), the original rows being added as
+				cuts when violated (see <include_opening_conshdlr>). Opening
+				duals and the SCIP plugins solving sub-problems are not
+				available in this mode.
 	*/
-	flp_solver( const problem & instance, bool relaxation );
+	flp_solver( const problem & instance, bool relaxation, bool lazy_opening = false );
 
 	/*
 		Destructor: flp_solver
@@ -41,13 +101,46 @@ public:
 
 	/*
 		Method: weighted_sum
+
+		Returns:
+			true if the problem has been solved to optimality. A solve stopped
+			before, even with a solution, returns false (see <interrupted>).
+			The same holds for the epsilon-constraint methods.
 	*/
 	bool weighted_sum( double lambda );
 
 	/*
 		Method: epsilon_constraint
+
+		Minimize the main objective subject to lower <= z(l) <= epsilon,
+		l being the other objective of a bi-objective problem, or the first
+		objective other than the main one.
+	*/
+	bool epsilon_constraint( double epsilon, double lower = -std::numeric_limits<double>::infinity() );
+
+	/*
+		Method: epsilon_constraint
+
+		Minimize the main objective subject to z(l) <= epsilon[l] for every
+		objective l, the value of the main objective being ignored.
 	*/
-	bool epsilon_constraint( double epsilon );
+	bool epsilon_constraint( const std::vector<double> & epsilon );
+
+	/*
+		Method: epsilon_constraint
+
+		Minimize the main objective subject to lower[l] <= z(l) <= epsilon[l]
+		for every objective l, the values of the main objective being ignored.
+	*/
+	bool epsilon_constraint( const std::vector<double> & epsilon, const std::vector<double> & lower );
+
+	/*
+		Method: interrupted
+
+		Return true if the last solve has been stopped by the budget or a
+		signal, neither optimality nor infeasibility being proven.
+	*/
+	bool interrupted() const;
 
 	/*
 		Method: z
@@ -59,6 +152,13 @@ public:
 	*/
 	double z( int k ) const;
 
+	/*
+		Method: z
+
+		Copy the values of all objectives for the last solution into y.
+	*/
+	void z( std::vector<double> & y ) const;
+
 	/*
 		Method: x
 	*/
@@ -91,9 +191,88 @@ public:
 
 	/*
 		Method: opening_dual
+
+		Only the nonzero opening duals are stored, the others are 0.
 	*/
 	double opening_dual( int i, int j ) const;
 
+	/*
+		Method: solution
+
+		Copy the values of the last solution, y(j) first then x(i,j) row
+		by row, into a vector. The vector is empty if there is no solution.
+	*/
+	void solution( std::vector<double> & values ) const;
+
+	/*
+		Method: set_start
+
+		Give a primal start to the next solve, in the format of <solution>.
+		It replaces the last solution, which is used by default when warm
+		start is enabled.
+	*/
+	void set_start( const std::vector<double> & values );
+
+	/*
+		Method: get_warm_start
+	*/
+	bool get_warm_start() const;
+
+	/*
+		Method: set_warm_start
+
+		Enable or disable warm start. When enabled, the previous solution is
+		given to SCIP as a primal start whenever it is still feasible, and the
+		dual bound of the previous epsilon-constraint is used as a lower bound
+		on the main objective when the feasible set has only shrunk.
+	*/
+	void set_warm_start( bool enable );
+
+	/*
+		Method: get_reoptimization
+	*/
+	bool get_reoptimization() const;
+
+	/*
+		Method: set_reoptimization
+
+		Enable or disable SCIP reoptimization. When enabled, the transformed
+		problem and the search tree are kept between solves: objectives are
+		changed with SCIPchgReoptObjective and epsilon-constraints that shrink
+		the feasible set are added as cuts to the transformed problem. Any
+		other change restarts from the original problem. Warm start is not
+		used since SCIP reuses its own information.
+	*/
+	void set_reoptimization( bool enable );
+
+	/*
+		Method: get_dual_extraction
+	*/
+	bool get_dual_extraction() const;
+
+	/*
+		Method: set_dual_extraction
+
+		Enable or disable the extraction of dual values after each solve,
+		disabled by default. The dual values are only meaningful for the
+		linear relaxation.
+	*/
+	void set_dual_extraction( bool enable );
+
+	/*
+		Method: get_heuristic
+	*/
+	bool get_heuristic() const;
+
+	/*
+		Method: set_heuristic
+
+		Enable or disable the facility location heuristic at the root node,
+		see include_flp_heur, disabled by default. It is not available for
+		the linear relaxation.
+	*/
+	void set_heuristic( bool enable );
+
 	/*
 		Method: get_main_objective
 	*/
@@ -104,6 +283,24 @@ public:
 	*/
 	void set_main_objective( int k );
 
+	/*
+		Method: get_augmentation
+	*/
+	double get_augmentation() const;
+
+	/*
+		Method: set_augmentation
+
+		Minimize z(k) + weight z(l) in epsilon-constraints instead of z(k),
+		k being the main objective, so that only efficient points are found
+		(augmented epsilon-constraint), z(l) being the sum of the other
+		objectives. This is the slack bonus of AUGMECON, the slack of
+		z(l) <= epsilon being epsilon - z(l). The weight must be small enough
+		to keep z(k) optimal, e.g. delta / (range of z(l)). 0 disables the
+		augmentation.
+	*/
+	void set_augmentation( double weight );
+
 	/*
 		Method: get_verblevel
 	*/
@@ -114,8 +311,126 @@ public:
 	*/
 	void set_verblevel( int level ) const;
 
+	/*
+		Method: statistics
+	*/
+	const solver_statistics & statistics() const;
+
+	/*
+		Method: merge_statistics
+
+		Add the statistics of another solver, e.g. one owned by a thread.
+	*/
+	void merge_statistics( const solver_statistics & other );
+
+	/*
+		Method: reset_statistics
+	*/
+	void reset_statistics();
+
+	/*
+		Method: get_trace
+	*/
+	trace_writer * get_trace() const;
+
+	/*
+		Method: set_trace
+
+		Write a record for every solve to a trace, 0 to disable. The trace is
+		not owned and can be shared by several solvers.
+	*/
+	void set_trace( trace_writer * trace );
+
+	/*
+		Method: get_budget
+	*/
+	budget * get_budget() const;
+
+	/*
+		Method: set_budget
+
+		Limit the solves to what is left of a budget, 0 to disable. Once the
+		budget is exhausted, solves return false without solving. The budget
+		is not owned and can be shared by several solvers.
+	*/
+	void set_budget( budget * limits );
+
+	/*
+		Method: get_lower_bound_set
+	*/
+	lower_bound_set * get_lower_bound_set() const;
+
+	/*
+		Method: set_lower_bound_set
+
+		Add the dual bound of every solve to a lower bound set, 0 to disable.
+		The set is not owned and can be shared by several solvers.
+	*/
+	void set_lower_bound_set( lower_bound_set * bounds );
+
+	/*
+		Method: get_observer
+	*/
+	point_observer * get_observer() const;
+
+	/*
+		Method: set_observer
+
+		Notify an observer of the points found by the methods, 0 to disable.
+		The observer is not owned.
+	*/
+	void set_observer( point_observer * observer );
+
+	/*
+		Method: get_solution_store
+	*/
+	solution_store * get_solution_store() const;
+
+	/*
+		Method: set_solution_store
+
+		Store the solutions of the points found by the methods, 0 to
+		disable. The store is not owned and can be shared by several solvers.
+	*/
+	void set_solution_store( solution_store * solutions );
+
+	/*
+		Method: get_candidate_pool
+	*/
+	candidate_pool * get_candidate_pool() const;
+
+	/*
+		Method: set_candidate_pool
+
+		Add the points of all the solutions found by SCIP to a candidate
+		pool, and cut off every solve at the best candidate satisfying its
+		epsilon constraints, 0 to disable. The pool is not owned and can be
+		shared by several solvers. Cutoffs are disabled with reoptimization,
+		which keeps the transformed problem between solves.
+	*/
+	void set_candidate_pool( candidate_pool * candidates );
+
+	/*
+		Method: copy_settings
+
+		Copy the settings of another solver: verbosity, warm start,
+		reoptimization, dual extraction, heuristic, trace, budget, lower bound set,
+		observer, solution store, candidate pool and augmentation.
+	*/
+	void copy_settings( const flp_solver & other );
+
+	/*
+		Method: get_build_time
+
+		Returns:
+			The wall clock time in seconds spent building the model.
+	*/
+	double get_build_time() const;
+
 	/*
 		Method: write_lp
+
+		Variables and constraints are named before the first write.
 	*/
 	void write_lp( FILE * fp = 0, const std::string & ext = "" ) const;
 
@@ -129,18 +444,45 @@ public:
 
 protected:
 	SCIP * _scip;
-	SCIP_SOL * _sol;
+	std::vector<double> _values;      // Last solution, same order as _vars
+	double _objective;                // Objective value of the last solution
+	std::vector<double> _objectives;  // All objective values of the last solution
 	std::vector< std::vector<SCIP_VAR *> > _x;
 	std::vector<SCIP_VAR *> _y;
+	std::vector<SCIP_VAR *> _vars;   // y(j) then x(i,j), same order as solution()
 	std::vector<SCIP_CONS *> _assign_cons;
 	std::vector<double>      _assign_dual;
 	std::vector<SCIP_CONS *> _cap_cons;
 	std::vector<double>      _cap_dual;
 	std::vector< std::vector<SCIP_CONS *> > _open_cons;
-	std::vector< std::vector<double> >      _open_dual;
-	SCIP_CONS * _epsilon_cons;
+	std::vector<SCIP_CONS *> _open_sum_cons;   // Aggregated opening rows of the lazy mode
+	std::vector< std::pair<int, double> > _open_dual;  // Nonzero duals (i*n+j, value), sorted
+	std::vector<SCIP_CONS *> _epsilon_cons;   // Bounds of every objective but the main one, 0 for it
+	std::vector<double> _epsilon_lhs, _epsilon_rhs;
+	std::vector<SCIP_CONS *> _epsilon_cuts;   // Epsilon-constraints of the transformed problem, 0 if none
+	SCIP_CONS * _bound_cons;          // Epsilon-constraint objective >= dual bound of the previous solve
+	double _dual_bound;               // Dual bound of the previous epsilon-constraint, or -infinity
+	std::vector<double> _start;
 	int _mainobj;
+	double _augmentation;             // Weight of z(l) in epsilon-constraints
+	std::vector<double> _weights;     // Objective of SCIP, as a weight per objective
 	bool _relaxation;
+	bool _lazy_opening;
+	bool _warm_start;
+	bool _reoptimization;
+	bool _dual_extraction;
+	bool _heuristic;
+	mutable bool _named;              // Whether name_model() has been called
+	double _build_time;
+	bool _interrupted;                // Whether the last solve has been stopped
+	solver_statistics _statistics;
+	trace_writer * _trace;
+	trace_record _record;             // Record of the current solve
+	budget * _budget;
+	lower_bound_set * _bounds;
+	point_observer * _observer;
+	solution_store * _solutions;
+	candidate_pool * _candidates;
 
 	/*
 		Method: initialize_problem
@@ -162,6 +504,14 @@ protected:
 	*/
 	void initialize_opening_constraints();
 
+	/*
+		Method: initialize_lazy_opening_constraints
+
+		Add the aggregated opening rows and the constraint separating
+		x(i,j) <= y(j).
+	*/
+	void initialize_lazy_opening_constraints();
+
 	/*
 		Method: initialize_capacity_constraints
 	*/
@@ -177,17 +527,139 @@ protected:
 	*/
 	void initialize_epsilon_constraints();
 
+	/*
+		Method: objective_coefficients
+
+		Get the coefficients of objective k, in the order of _vars.
+	*/
+	void objective_coefficients( int k, std::vector<double> & obj ) const;
+
+	/*
+		Method: epsilon_coefficients
+
+		Get the coefficients of the epsilon-constraint objective, the main
+		objective plus the augmentation, in the order of _vars.
+	*/
+	void epsilon_coefficients( std::vector<double> & obj ) const;
+
+	/*
+		Method: name_model
+
+		Name the variables and the constraints, which are created without
+		names to save time. Only possible in problem stage.
+	*/
+	void name_model() const;
+
 	/*
 		Method: store_dual
+
+		Store the dual values of the last solve. Must be called after the
+		solution is fetched, since slack opening constraints are skipped.
 	*/
 	void store_dual();
+
+	/*
+		Method: optimize
+
+		Solve the current problem, warm started if enabled, and free the
+		transformed problem.
+
+		Returns:
+			true if the problem has been solved to optimality.
+	*/
+	bool optimize();
+
+	/*
+		Method: evaluate
+
+		Compute all objective values of the last solution.
+	*/
+	void evaluate();
+
+	/*
+		Method: evaluate
+
+		Compute all objective values of a solution.
+	*/
+	void evaluate( const std::vector<double> & values, std::vector<double> & objectives ) const;
+
+	/*
+		Method: set_cutoff
+
+		Limit the objective of the next solve to the best candidate.
+	*/
+	void set_cutoff();
+
+	/*
+		Method: harvest
+
+		Add the points of all the solutions of the current solve to the
+		candidate pool.
+	*/
+	void harvest();
+
+	/*
+		Method: restart
+
+		Free the transformed problem if any, so that the original problem can
+		be modified.
+	*/
+	void restart();
+
+	/*
+		Method: change_objective
+
+		Set the objective coefficients of all variables, in the order of _vars.
+	*/
+	void change_objective( std::vector<double> & obj );
+
+	/*
+		Method: add_epsilon_cut
+
+		Add the current epsilon-constraint to the transformed problem, or
+		tighten the one added by the previous solves.
+	*/
+	void add_epsilon_cut();
+
+	/*
+		Method: release_epsilon_cuts
+
+		Release the epsilon-constraints of the transformed problem, before it
+		is freed.
+	*/
+	void release_epsilon_cuts();
+
+	/*
+		Method: add_start
+
+		Give the start solution to SCIP if it satisfies the epsilon constraint.
+	*/
+	void add_start();
 };
 
 ////////////////////////////////////////////////////////////////////////////////
 
+inline solver_statistics & solver_statistics::operator += ( const solver_statistics & other )
+{
+	solves += other.solves;
+	nodes += other.nodes;
+	lp_iterations += other.lp_iterations;
+	return *this;
+}
+
 inline double flp_solver::z() const
 {
-	return SCIPgetSolOrigObj( _scip, _sol );
+	return _objective;
+}
+
+inline double flp_solver::z( int k ) const
+{
+	return _objectives[k];
+}
+
+inline void flp_solver::z( std::vector<double> & y ) const
+{
+	y = _objectives;
 }
 
 inline bool flp_solver::x( int i, int j ) const
@@ -202,12 +674,12 @@ inline bool flp_solver::y( int j ) const
 
 inline double flp_solver::x_real( int i, int j ) const
 {
-	return SCIPgetSolVal( _scip, _sol, _x[i][j] );
+	return _values[instance.num_facilities + i*instance.num_facilities + j];
 }
 
 inline double flp_solver::y_real( int j ) const
 {
-	return SCIPgetSolVal( _scip, _sol, _y[j] );
+	return _values[j];
 }
 
 inline double flp_solver::capacity_dual( int j ) const
@@ -222,7 +694,121 @@ inline double flp_solver::assignment_dual( int i ) const
 
 inline double flp_solver::opening_dual( int i, int j ) const
 {
-	return _open_dual[i][j];
+	std::pair<int, double> key( i*instance.num_facilities + j, -std::numeric_limits<double>::infinity() );
+	std::vector< std::pair<int, double> >::const_iterator it;
+
+	it = std::lower_bound( _open_dual.begin(), _open_dual.end(), key );
+	return ( it != _open_dual.end() && it->first == key.first ) ? it->second : 0.;
+}
+
+inline bool flp_solver::get_warm_start() const
+{
+	return _warm_start;
+}
+
+inline void flp_solver::set_warm_start( bool enable )
+{
+	_warm_start = enable;
+}
+
+inline bool flp_solver::get_reoptimization() const
+{
+	return _reoptimization;
+}
+
+inline bool flp_solver::get_dual_extraction() const
+{
+	return _dual_extraction;
+}
+
+inline void flp_solver::set_dual_extraction( bool enable )
+{
+	_dual_extraction = enable;
+}
+
+inline bool flp_solver::get_heuristic() const
+{
+	return _heuristic;
+}
+
+inline const solver_statistics & flp_solver::statistics() const
+{
+	return _statistics;
+}
+
+inline void flp_solver::merge_statistics( const solver_statistics & other )
+{
+	_statistics += other;
+}
+
+inline void flp_solver::reset_statistics()
+{
+	_statistics = solver_statistics();
+}
+
+inline trace_writer * flp_solver::get_trace() const
+{
+	return _trace;
+}
+
+inline void flp_solver::set_trace( trace_writer * trace )
+{
+	_trace = trace;
+}
+
+inline bool flp_solver::interrupted() const
+{
+	return _interrupted;
+}
+
+inline budget * flp_solver::get_budget() const
+{
+	return _budget;
+}
+
+inline lower_bound_set * flp_solver::get_lower_bound_set() const
+{
+	return _bounds;
+}
+
+inline void flp_solver::set_lower_bound_set( lower_bound_set * bounds )
+{
+	_bounds = bounds;
+}
+
+inline point_observer * flp_solver::get_observer() const
+{
+	return _observer;
+}
+
+inline void flp_solver::set_observer( point_observer * observer )
+{
+	_observer = observer;
+}
+
+inline solution_store * flp_solver::get_solution_store() const
+{
+	return _solutions;
+}
+
+inline void flp_solver::set_solution_store( solution_store * solutions )
+{
+	_solutions = solutions;
+}
+
+inline candidate_pool * flp_solver::get_candidate_pool() const
+{
+	return _candidates;
+}
+
+inline void flp_solver::set_candidate_pool( candidate_pool * candidates )
+{
+	_candidates = candidates;
+}
+
+inline double flp_solver::get_build_time() const
+{
+	return _build_time;
 }
 
 inline int flp_solver::get_main_objective() const
@@ -230,4 +816,9 @@ inline int flp_solver::get_main_objective() const
 	return _mainobj;
 }
 
+inline double flp_solver::get_augmentation() const
+{
+	return _augmentation;
+}
+
 #endif
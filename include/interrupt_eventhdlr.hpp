@@ -0,0 +1,34 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef INTERRUPT_EVENTHDLR_HPP
+#define INTERRUPT_EVENTHDLR_HPP
+
+#include <scip/scip.h>
+
+/*
+	Function: include_interrupt_eventhdlr
+
+	Include an event handler which interrupts the solve, after the current
+	LP or node, once SIGINT or SIGTERM has been received (see
+	<budget::catch_signals>). Unlike the SCIP ctrl-c handler, it works with
+	several SCIP instances solving in parallel.
+
+	Parameters:
+		scip - A SCIP instance.
+*/
+SCIP_RETCODE include_interrupt_eventhdlr( SCIP * scip );
+
+#endif
@@ -0,0 +1,44 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef JSON_HPP
+#define JSON_HPP
+
+#include <iostream>
+#include <string>
+#include <cstddef>
+
+/*
+	Function: write_json_string
+
+	Write a JSON string, with quotes and escapes.
+*/
+void write_json_string( std::ostream & os, const std::string & value );
+
+/*
+	Function: write_json_number
+
+	Write a number in JSON, null if it is not finite.
+*/
+void write_json_number( std::ostream & os, double value );
+
+/*
+	Function: write_json_array
+
+	Write an array of numbers in JSON.
+*/
+void write_json_array( std::ostream & os, const double * values, std::size_t size );
+
+#endif
@@ -0,0 +1,123 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef LAGRANGIAN_HPP
+#define LAGRANGIAN_HPP
+
+#include "problem.hpp"
+#include <vector>
+#include <utility>
+
+/*
+	Class: lagrangian
+
+	Lower bounds of weighted sums of the objectives by Lagrangian relaxation
+	of the assignment constraints sum_j x(i,j) = 1, with a multiplier u(i)
+	per customer. The relaxed problem decomposes per facility: without
+	capacities, facility j is worth f(j) + sum_i min(0, c(i,j) - u(i)); with
+	capacities, the customers are chosen by a continuous knapsack, and the
+	facilities open must cover the total demand. The multipliers are
+	improved by subgradient steps and kept from one bound to the next.
+
+	The bounds are valid for the single-source, multi-source and relaxed
+	problems, whatever the epsilon constraints.
+*/
+class lagrangian
+{
+public:
+	/*
+		Constructor: lagrangian
+	*/
+	explicit lagrangian( const problem & instance );
+
+	/*
+		Method: bound
+
+		Compute a lower bound of min sum_k weights(k) z(k).
+
+		Parameters:
+			weights - The weight of each objective.
+			target - An upper bound of the minimum, which guides the steps
+			         and stops them once reached (see <tolerance>), or
+			         infinity.
+			iterations - The maximal number of subgradient steps.
+
+		Returns:
+			The best bound found.
+	*/
+	double bound( const std::vector<double> & weights, double target, int iterations );
+
+	/*
+		Method: set_multipliers
+
+		Start the next bound from some multipliers, such as the duals of the
+		assignment constraints of a linear relaxation.
+	*/
+	void set_multipliers( const std::vector<double> & u );
+
+	/*
+		Method: multipliers
+	*/
+	const std::vector<double> & multipliers() const;
+
+	/*
+		Function: tolerance
+
+		Return the distance to a target under which a bound reaches it. It
+		is absolute and as tight as the epsilon of SCIP (1e-9), which would
+		not tell a smaller improvement of a weighted sum either.
+	*/
+	static double tolerance();
+
+private:
+	const problem & _instance;
+	std::vector<double> _cost;     // Weighted c(i,j)
+	std::vector<double> _fixed;    // Weighted f(j)
+	std::vector<double> _u;        // Multipliers
+	std::vector<double> _x;        // x(i,j) of the relaxed solution
+	std::vector<double> _value;    // Value of each facility in the relaxed problem
+	std::vector< std::pair<double, int> > _items;   // Sorted customers or facilities
+
+	/*
+		Method: evaluate
+
+		Solve the relaxed problem for the multipliers u.
+
+		Parameters:
+			u - The multipliers.
+			subgradient - 1 - sum_j x(i,j) for each customer i.
+
+		Returns:
+			The value of the relaxed problem, a lower bound.
+	*/
+	double evaluate( const std::vector<double> & u, std::vector<double> & subgradient );
+
+	/*
+		Method: knapsack
+
+		Choose the customers of facility j for the multipliers u, with
+		capacities, and return its value.
+	*/
+	double knapsack( int j, const std::vector<double> & u );
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline const std::vector<double> & lagrangian::multipliers() const
+{
+	return _u;
+}
+
+#endif
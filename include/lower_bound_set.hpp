@@ -0,0 +1,120 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef LOWER_BOUND_SET_HPP
+#define LOWER_BOUND_SET_HPP
+
+#include "archive.hpp"
+#include "thread.hpp"
+#include <vector>
+
+/*
+	Class: lower_bound_set
+
+	A bi-objective lower bound set built from the dual bounds of the solves,
+	valid even if the solves have been stopped early. Any nondominated
+	point satisfies all the inequalities of the set. Points can be added by
+	several threads.
+*/
+class lower_bound_set
+{
+public:
+	/*
+		Constructor: lower_bound_set
+	*/
+	lower_bound_set();
+
+	/*
+		Method: add_weighted_sum
+
+		Add the inequality (1-lambda) z(k) + lambda z(l) >= bound, l being
+		the other objective.
+	*/
+	void add_weighted_sum( int k, double lambda, double bound );
+
+	/*
+		Method: add_epsilon_constraint
+
+		Add the implication lower <= z(l) <= epsilon => z(k) >= bound, l
+		being the other objective.
+	*/
+	void add_epsilon_constraint( int k, double lower, double epsilon, double bound );
+
+	/*
+		Method: add_nadir_bound
+
+		Add the inequality z(k) <= bound for every nondominated point, e.g.
+		the value of z(k) at an optimal solution of min z(l).
+	*/
+	void add_nadir_bound( int k, double bound );
+
+	/*
+		Method: clear
+	*/
+	void clear();
+
+	/*
+		Method: gap
+
+		Compute the area of the region where nondominated points missing from
+		a front may lie: not dominated by the front, satisfying the lower bound
+		set and the nadir bounds. The nadir point of the front is not a bound:
+		a stopped run may have missed the points beyond it.
+
+		Parameters:
+			front - The points found so far.
+
+		Returns:
+			The area of the region, infinity if it is not bounded, e.g. if no
+			nadir bound is known and the missing points are not excluded by
+			the lower bound set.
+	*/
+	double gap( const archive & front ) const;
+
+	/*
+		Function: hypervolume
+
+		Parameters:
+			front - A bi-objective front.
+
+		Returns:
+			The area dominated by the front and dominating its nadir point.
+	*/
+	static double hypervolume( const archive & front );
+
+private:
+	struct halfspace
+	{
+		double a[2];   // a[0] z(0) + a[1] z(1) >= b
+		double b;
+	};
+
+	struct box
+	{
+		int k;         // lower <= z(1-k) <= upper => z(k) >= bound
+		double lower, upper, bound;
+	};
+
+	std::vector<halfspace> _halfspaces;
+	std::vector<box> _boxes;
+	double _nadir[2];      // z(k) <= _nadir[k] for every nondominated point
+	mutable mutex _lock;   // Protect all the members above
+
+	// Non copyable
+	lower_bound_set( const lower_bound_set & );
+	lower_bound_set & operator = ( const lower_bound_set & );
+};
+
+#endif
@@ -0,0 +1,101 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <string>
+#include <cstddef>
+
+/*
+	Class: mapped_file
+
+	A read-only file mapped in memory.
+*/
+class mapped_file
+{
+public:
+	/*
+		Constructor: mapped_file
+	*/
+	mapped_file();
+
+	/*
+		Constructor: mapped_file
+
+		Map a file, see <open>.
+	*/
+	explicit mapped_file( const std::string & filename );
+
+	/*
+		Destructor: mapped_file
+	*/
+	~mapped_file();
+
+	/*
+		Method: open
+
+		Map a file in memory. Throw std::runtime_error on failure.
+	*/
+	void open( const std::string & filename );
+
+	/*
+		Method: close
+	*/
+	void close();
+
+	/*
+		Method: is_open
+	*/
+	bool is_open() const;
+
+	/*
+		Method: data
+	*/
+	const char * data() const;
+
+	/*
+		Method: size
+	*/
+	std::size_t size() const;
+
+private:
+	void * _data;
+	std::size_t _size;
+	bool _open;
+
+	// Non copyable
+	mapped_file( const mapped_file & );
+	mapped_file & operator = ( const mapped_file & );
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline bool mapped_file::is_open() const
+{
+	return _open;
+}
+
+inline const char * mapped_file::data() const
+{
+	return static_cast<const char *>( _data );
+}
+
+inline std::size_t mapped_file::size() const
+{
+	return _size;
+}
+
+#endif
@@ -0,0 +1,198 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef METHODS_HPP
+#define METHODS_HPP
+
+#include "flp_solver.hpp"
+#include "archive.hpp"
+#include "checkpoint.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+
+// The methods read their options (objective, from, step, lambda, verbose...)
+// from the argument class. The statistics of the threads are merged into
+// the statistics of solve. The methods which take a checkpoint save their
+// state to it from time to time, and resume from it if it has been loaded.
+
+/*
+	Function: lexicographic
+
+	Get the lexicographic solutions of a problem.
+
+	Parameters:
+		solve - A flp_solver instance.
+
+	Returns:
+		A set of lexicographic solutions.
+*/
+archive lexicographic( flp_solver & solve );
+
+/*
+	Function: weighted_sum
+
+	Get the solution of a weighted sum.
+
+	Parameters:
+		solve - A flp_solver instance.
+
+	Returns:
+		A set of one solution.
+*/
+archive weighted_sum( flp_solver & solve );
+
+/*
+	Function: dichotomic_method
+
+	Get the supported solutions of a problem using a dichotomic method.
+
+	Parameters:
+		solve - A flp_solver instance.
+		state - A checkpoint, or 0.
+
+	Returns:
+		A set of supported solutions.
+*/
+archive dichotomic_method( flp_solver & solve, checkpoint * state = 0 );
+
+/*
+	Function: parallel_dichotomic_method
+
+	Get the supported solutions of a problem using a dichotomic method,
+	the triangles being solved concurrently by a pool of threads.
+
+	Parameters:
+		solve - A flp_solver instance.
+		num_threads - The number of threads.
+		state - A checkpoint, or 0.
+
+	Returns:
+		A set of supported solutions.
+*/
+archive parallel_dichotomic_method( flp_solver & solve, int num_threads, checkpoint * state = 0 );
+
+/*
+	Function: epsilon_constraint
+
+	Apply epsilon-constraint method to a problem.
+
+	Parameters:
+		solve - A flp_solver instance.
+		state - A checkpoint, or 0.
+
+	Returns:
+		A set of efficient solutions.
+*/
+archive epsilon_constraint( flp_solver & solve, checkpoint * state = 0 );
+
+/*
+	Function: parallel_epsilon_constraint
+
+	Apply epsilon-constraint method to a problem, the range of the second
+	objective being split into slabs swept concurrently by a pool of threads.
+
+	Parameters:
+		solve - A flp_solver instance.
+		num_threads - The number of threads.
+		num_slabs - The number of slabs.
+		state - A checkpoint, or 0.
+
+	Returns:
+		A set of efficient solutions.
+*/
+archive parallel_epsilon_constraint( flp_solver & solve, int num_threads, int num_slabs, checkpoint * state = 0 );
+
+/*
+	Function: box_method
+
+	Get the nondominated points of a problem with any number of objectives
+	using the box method of Kirlik and Sayin. The region of the other
+	objectives is split into boxes, each solve either finds a new point or
+	proves a box empty, and the augmented epsilon-constraint ensures the
+	points are efficient.
+
+	Parameters:
+		solve - A flp_solver instance.
+		state - A checkpoint, or 0.
+
+	Returns:
+		A set of efficient solutions.
+*/
+archive box_method( flp_solver & solve, checkpoint * state = 0 );
+
+/*
+	Function: run_method
+
+	Run a method, with the parallel variant if there are several threads.
+	Problems with more than two objectives are solved by <box_method>,
+	other methods than efficient throw std::runtime_error on them.
+
+	Parameters:
+		solve - A flp_solver instance.
+		method - lexicographic, weighted-sum, supported or efficient.
+		state - A checkpoint, or 0.
+
+	Returns:
+		The points found.
+*/
+archive run_method( flp_solver & solve, const std::string & method, checkpoint * state = 0 );
+
+/*
+	Function: display_solution
+
+	Display the x and y values to the terminal.
+
+	Parameters:
+		solve - A flp_solver instance.
+		os - An output stream.
+*/
+void display_solution( const flp_solver & solve, std::ostream & os );
+
+/*
+	Function: display
+
+	Display a point to the terminal.
+
+	Parameters:
+		z - A point.
+		os - An output stream.
+*/
+void display( const std::vector<double> & z, std::ostream & os );
+
+/*
+	Function: display
+
+	Display the Pareto front to the terminal.
+
+	Parameters:
+		pareto_front - A Pareto front.
+		os - An output stream.
+*/
+void display( const archive & pareto_front, std::ostream & os );
+
+/*
+	Function: display_last
+
+	Display the last solution to the terminal if verbose mode is enabled.
+
+	Parameters:
+		solve - A flp_solver instance.
+		z - The last point.
+		os - An output stream.
+*/
+void display_last( const flp_solver & solve, const std::vector<double> & z, std::ostream & os );
+
+#endif
@@ -0,0 +1,51 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPENING_CONSHDLR_HPP
+#define OPENING_CONSHDLR_HPP
+
+#include <scip/scip.h>
+
+/*
+	Function: include_opening_conshdlr
+
+	Include the constraint handler of the facility opening constraints
+	x(i,j) <= y(j) in SCIP. The constraints are not part of the model: they
+	are checked on every solution, and the violated ones are added as cuts.
+
+	Parameters:
+		scip - A SCIP instance.
+*/
+SCIP_RETCODE include_opening_conshdlr( SCIP * scip );
+
+/*
+	Function: create_opening_cons
+
+	Create a constraint enforcing x(i,j) <= y(j) for all i and j. The
+	constraint handler must have been included.
+
+	Parameters:
+		scip - A SCIP instance.
+		cons - The created constraint.
+		name - The name of the constraint.
+		num_customers - The number of customers m.
+		num_facilities - The number of facilities n.
+		x - The m*n variables x(i,j), row by row.
+		y - The n variables y(j).
+*/
+SCIP_RETCODE create_opening_cons( SCIP * scip, SCIP_CONS ** cons, const char * name,
+	int num_customers, int num_facilities, SCIP_VAR ** x, SCIP_VAR ** y );
+
+#endif
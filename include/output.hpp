@@ -0,0 +1,184 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OUTPUT_HPP
+#define OUTPUT_HPP
+
+#include "problem.hpp"
+#include "flp_solver.hpp"
+#include "archive.hpp"
+#include "solution_store.hpp"
+#include "thread.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+/*
+	Class: output_header
+
+	Header of the bin output format, followed by records made of a
+	uint32_t type and the p objectives as doubles. Records whose type has
+	the has_solution bit then hold the open facilities as a bitset of
+	(n+7)/8 bytes, and either one uint32_t facility per customer
+	(single-source) or, per customer, a uint32_t count followed by count
+	pairs of uint32_t facility and double value (multi-source). Fields are
+	packed, in native byte order.
+*/
+struct output_header
+{
+	char     magic[8];          // "MOFLPOUT"
+	uint32_t version;           // Format version
+	uint32_t byte_order;        // byte_order_mark, written natively
+	uint32_t num_objectives;    // p
+	uint32_t num_customers;     // m
+	uint32_t num_facilities;    // n
+	uint32_t flags;             // has_solutions | single_source
+
+	enum
+	{
+		current_version = 1,
+		byte_order_mark = 0x01020304,
+		has_solutions = 1,
+		single_source = 2,
+		record_point = 1,
+		record_nondominated = 2,
+		record_end = 3,
+		has_solution = 0x100
+	};
+};
+
+/*
+	Class: front_writer
+
+	Stream the points to an output as soon as they are found, then mark the
+	nondominated ones with <finish>. Each point is formatted in a buffer and
+	written at once. The solutions, if any, come from a <solution_store>,
+	in which the points must be inserted before being written.
+
+	The formats are:
+
+	- ndjson - {"type":"point","z":[..],"open":[..],"assign":[..]} lines,
+	  assign holding a facility per customer, or [facility,value] pairs per
+	  customer for multi-source problems, then {"type":"nondominated"} lines
+	  and a {"type":"end"} line
+	- csv - type,z1,..,zp[,open,assign] rows, the lists being separated by
+	  spaces, and the customers of multi-source problems by semicolons
+	- bin - see <output_header>
+*/
+class front_writer : public point_observer
+{
+public:
+	enum format
+	{
+		ndjson,
+		csv,
+		bin
+	};
+
+	/*
+		Function: parse_format
+
+		Throw std::runtime_error if the name is not a format.
+	*/
+	static format parse_format( const std::string & name );
+
+	/*
+		Constructor: front_writer
+
+		Write the header of the output.
+
+		Parameters:
+			os - An output stream.
+			type - The format.
+			instance - The problem solved.
+			solutions - The solutions of the points, or 0.
+	*/
+	front_writer( std::ostream & os, format type, const problem & instance,
+		const solution_store * solutions );
+
+	/*
+		Method: found
+
+		Write a point and its solution.
+	*/
+	void found( const flp_solver & solve, const std::vector<double> & z );
+
+	/*
+		Method: finish
+
+		Write the nondominated points and the end of the output.
+	*/
+	void finish( const archive & pareto_front );
+
+private:
+	std::ostream & _os;
+	format _format;
+	const problem & _instance;
+	const solution_store * _solutions;
+	std::string _buffer;    // Record being formatted
+	mutex _lock;            // Protect _os and _buffer
+
+	/*
+		Method: record
+
+		Format a point and its solution.
+	*/
+	void record( const char * type, const double * z );
+
+	/*
+		Method: solution
+
+		Format the index-th solution of the store.
+	*/
+	void solution( int index );
+
+	/*
+		Method: flush
+
+		Write the buffer to the output.
+	*/
+	void flush();
+
+	/*
+		Method: number
+	*/
+	void number( double value );
+
+	/*
+		Method: integer
+	*/
+	void integer( int value );
+
+	/*
+		Method: binary
+	*/
+	template <typename T>
+	void binary( const T & value );
+
+	// Non copyable
+	front_writer( const front_writer & );
+	front_writer & operator = ( const front_writer & );
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+inline void front_writer::binary( const T & value )
+{
+	_buffer.append( reinterpret_cast<const char *>( &value ), sizeof( T ) );
+}
+
+#endif
@@ -16,8 +16,24 @@
 #ifndef PROBLEM_HPP
 #define PROBLEM_HPP
 
+#include "aligned_array.hpp"
 #include <iostream>
 #include <vector>
+#include <cstddef>
+
+/*
+	Class: cost_view
+
+	A strided view on a sequence of costs.
+*/
+struct cost_view
+{
+	const double * data;      // First element
+	std::ptrdiff_t stride;    // Distance between two consecutive elements
+
+	cost_view( const double * data, std::ptrdiff_t stride ) : data( data ), stride( stride ) {}
+	double operator [] ( int index ) const { return data[index * stride]; }
+};
 
 /*
 	Class: problem
@@ -47,14 +63,57 @@ struct problem
 	*/
 	problem( bool capacitated = false, bool single_source = true );
 
+	/*
+		Method: c
+
+		Cost of assigning customer i to facility j in objective k.
+	*/
+	double c( int k, int i, int j ) const;
+
+	/*
+		Method: c
+	*/
+	double & c( int k, int i, int j );
+
+	/*
+		Method: c_row
+
+		Costs of customer i for all facilities in objective k (objective-major
+		view, contiguous).
+	*/
+	const double * c_row( int k, int i ) const;
+
+	/*
+		Method: c_column
+
+		Costs of facility j for all customers in objective k (facility-major
+		view, stride num_facilities).
+	*/
+	cost_view c_column( int k, int j ) const;
+
+	/*
+		Method: c_objective
+
+		All the costs of objective k, customer by customer.
+	*/
+	const double * c_objective( int k ) const;
+
+	/*
+		Method: resize_costs
+
+		Resize the assignment costs according to the numbers of objectives,
+		customers and facilities. All costs are set to zero.
+	*/
+	void resize_costs();
+
 	// UFLP information
 
 	int num_objectives,   // Number of objectives
 	    num_customers,    // Number of customers
 	    num_facilities;   // Number of facilities
 
-	std::vector< std::vector< std::vector<double> > > c; // Cost of assignments
-	std::vector< std::vector<double> > f;                // Cost of opening
+	aligned_array<double> costs;             // Cost of assignments, see c()
+	std::vector< std::vector<double> > f;    // Cost of opening
 
 	// CFLP information
 
@@ -69,4 +128,31 @@ struct problem
 std::istream & operator >> ( std::istream & is, problem & instance );
 std::ostream & operator << ( std::ostream & os, const problem & instance );
 
+////////////////////////////////////////////////////////////////////////////////
+
+inline double problem::c( int k, int i, int j ) const
+{
+	return costs[( (std::size_t)k * num_customers + i ) * num_facilities + j];
+}
+
+inline double & problem::c( int k, int i, int j )
+{
+	return costs[( (std::size_t)k * num_customers + i ) * num_facilities + j];
+}
+
+inline const double * problem::c_row( int k, int i ) const
+{
+	return costs.data() + ( (std::size_t)k * num_customers + i ) * num_facilities;
+}
+
+inline cost_view problem::c_column( int k, int j ) const
+{
+	return cost_view( costs.data() + (std::size_t)k * num_customers * num_facilities + j, num_facilities );
+}
+
+inline const double * problem::c_objective( int k ) const
+{
+	return costs.data() + (std::size_t)k * num_customers * num_facilities;
+}
+
 #endif
@@ -0,0 +1,113 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef READER_HPP
+#define READER_HPP
+
+#include "problem.hpp"
+#include "mapped_file.hpp"
+#include <stdexcept>
+#include <string>
+
+/*
+	Class: parse_error
+
+	Exception thrown when an instance is malformed.
+*/
+class parse_error : public std::runtime_error
+{
+public:
+	/*
+		Constructor: parse_error
+
+		Parameters:
+			what - A message, prefixed with the position.
+			line - Line of the error, starting from 1.
+			column - Column of the error, starting from 1.
+	*/
+	parse_error( const std::string & what, int line, int column );
+
+	/*
+		Method: line
+	*/
+	int line() const;
+
+	/*
+		Method: column
+	*/
+	int column() const;
+
+private:
+	int _line, _column;
+};
+
+/*
+	Function: read_instance
+
+	Read an instance in the text format (see instances/generate_cflp.sh)
+	from a file mapped in memory. This is equivalent to operator >> but
+	numbers are scanned directly from memory, without streams nor locales.
+	The numbers of objectives, customers and facilities are validated.
+
+	Parameters:
+		filename - The instance file name.
+		instance - The problem to fill; capacitated and num_objectives must
+		           be set beforehand.
+
+	Throws:
+		std::runtime_error if the file cannot be read, parse_error if it is
+		malformed.
+*/
+void read_instance( const std::string & filename, problem & instance );
+
+/*
+	Function: read_instance
+
+	Read an instance in the text format from a memory buffer.
+
+	Parameters:
+		begin - Beginning of the buffer.
+		end - End of the buffer.
+		instance - The problem to fill.
+*/
+void read_instance( const char * begin, const char * end, problem & instance );
+
+/*
+	Function: load_instance
+
+	Load an instance in the text or the binary format, detected from the
+	content of the file. A binary instance refers to the mapped file, which
+	must outlive the problem (see map_binary_instance).
+
+	Parameters:
+		filename - The instance file name.
+		file - A mapped_file receiving the mapping.
+		instance - The problem to fill.
+*/
+void load_instance( const std::string & filename, mapped_file & file, problem & instance );
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline int parse_error::line() const
+{
+	return _line;
+}
+
+inline int parse_error::column() const
+{
+	return _column;
+}
+
+#endif
@@ -0,0 +1,51 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SERVER_HPP
+#define SERVER_HPP
+
+#include "trace.hpp"
+#include <string>
+
+/*
+	Function: serve
+
+	Answer requests until "quit", the end of the input or SIGINT/SIGTERM,
+	with the options of the argument class. Requests are lines:
+
+	- solve <method> <size> [time-limit=<s>] [node-limit=<n>], followed by
+	  an instance of size bytes in the text format
+	- open <method> <file> [time-limit=<s>] [node-limit=<n>], to read an
+	  instance file of the server, text or binary
+	- quit
+
+	The method is lexicographic, weighted-sum, supported or efficient.
+	Responses are JSON lines: an {"event":"point"} line for every point
+	as soon as it is found, then one {"event":"done"} line with the status,
+	times, statistics and front, or one {"event":"error"} line. The model
+	of the last instance is kept, so that another request on the same
+	instance does not build it again.
+
+	Parameters:
+		address - The path of a Unix domain socket, whose connections are
+		          served one after the other, or empty for stdin/stdout.
+		trace - The trace of all solves, or 0.
+
+	Throws:
+		std::runtime_error if the socket cannot be created.
+*/
+void serve( const std::string & address, trace_writer * trace );
+
+#endif
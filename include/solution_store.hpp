@@ -0,0 +1,241 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SOLUTION_STORE_HPP
+#define SOLUTION_STORE_HPP
+
+#include "problem.hpp"
+#include "archive.hpp"
+#include "thread.hpp"
+#include <map>
+#include <vector>
+#include <string>
+#include <utility>
+#include <cstddef>
+#include <stdint.h>
+
+class flp_solver;
+
+/*
+	Class: solution_header
+
+	Header of the solution file format, followed by the solutions, each one
+	made of the p objectives as doubles, the open facilities as a bitset of
+	(n+7)/8 bytes, and either one uint32_t facility per customer
+	(single-source) or, per customer, a uint32_t count followed by count
+	uint32_t facilities and count double values (multi-source). Fields are
+	packed, in native byte order.
+*/
+struct solution_header
+{
+	char     magic[8];          // "MOFLPSOL"
+	uint32_t version;           // Format version
+	uint32_t byte_order;        // byte_order_mark, written natively
+	uint32_t num_objectives;    // p
+	uint32_t num_customers;     // m
+	uint32_t num_facilities;    // n
+	uint32_t single_source;     // 1 if one facility per customer
+	uint32_t size;              // Number of solutions
+	uint32_t reserved;          // Zero, pads the header to 40 bytes
+
+	enum
+	{
+		current_version = 1,
+		byte_order_mark = 0x01020304
+	};
+};
+
+/*
+	Class: solution_store
+
+	The solutions of the points of a front, stored compactly in flat arrays:
+	the open facilities as a bitset and, for single-source problems, one
+	facility per customer, or else the nonzero assignments as sparse
+	(facility, value) pairs. Facilities are numbered from 0.
+
+	Solutions can be inserted by several threads, but not while the store is
+	read.
+*/
+class solution_store
+{
+public:
+	/*
+		Constructor: solution_store
+
+		Parameters:
+			instance - The problem solved.
+			single_source - Whether the solutions assign each customer to one
+			                facility, false for a linear relaxation.
+	*/
+	solution_store( const problem & instance, bool single_source );
+
+	/*
+		Method: insert
+
+		Store the current solution of a solver unless the point already has
+		one.
+
+		Parameters:
+			solve - A flp_solver holding the solution.
+			z - The point of the solution.
+	*/
+	void insert( const flp_solver & solve, const std::vector<double> & z );
+
+	/*
+		Method: retain
+
+		Remove the solutions of the points missing from a front, after which
+		the indices change.
+	*/
+	void retain( const archive & front );
+
+	/*
+		Method: clear
+	*/
+	void clear();
+
+	/*
+		Method: find
+
+		Return the index of the solution of a point, or -1.
+	*/
+	int find( const double * z ) const;
+
+	/*
+		Method: size
+	*/
+	int size() const;
+
+	/*
+		Method: single_source
+	*/
+	bool single_source() const;
+
+	/*
+		Method: point
+
+		Return a pointer to the objectives of the index-th solution.
+	*/
+	const double * point( int index ) const;
+
+	/*
+		Method: open
+
+		Return true if facility j is open in the index-th solution.
+	*/
+	bool open( int index, int j ) const;
+
+	/*
+		Method: facility
+
+		Return the facility of customer i in the index-th solution of a
+		single-source store.
+	*/
+	int facility( int index, int i ) const;
+
+	/*
+		Method: assignment
+
+		Get the nonzero assignments of customer i in the index-th solution,
+		as (facility, value) pairs.
+	*/
+	void assignment( int index, int i, std::vector< std::pair<int, double> > & pairs ) const;
+
+	/*
+		Method: bytes
+
+		Return the memory used by the solutions.
+	*/
+	std::size_t bytes() const;
+
+	/*
+		Method: write
+
+		Write the solutions to a file, see <solution_header>. Throw
+		std::runtime_error on failure.
+	*/
+	void write( const std::string & filename ) const;
+
+	/*
+		Method: read
+
+		Replace the solutions by the ones of a file written by <write> for
+		the same problem. Throw std::runtime_error on failure.
+	*/
+	void read( const std::string & filename );
+
+private:
+	const problem & _instance;
+	bool _single_source;
+	std::size_t _bitset_size;                // Bytes of a bitset of facilities
+	std::vector<double> _points;             // p per solution
+	std::vector<unsigned char> _open;        // _bitset_size per solution
+	std::vector<uint32_t> _facility;         // m per solution, or a facility per pair
+	std::vector<double> _value;              // A value per pair (multi-source)
+	std::vector<std::size_t> _start;         // First pair of each customer, then the end
+	std::map<std::vector<double>, int> _index;
+	mutex _lock;                             // Protect insert
+
+	/*
+		Method: customer_begin
+
+		Return the first pair of customer i in the index-th solution
+		(multi-source).
+	*/
+	std::size_t customer_begin( int index, int i ) const;
+
+	/*
+		Method: reindex
+	*/
+	void reindex();
+
+	// Non copyable
+	solution_store( const solution_store & );
+	solution_store & operator = ( const solution_store & );
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline int solution_store::size() const
+{
+	return (int)( _points.size() / _instance.num_objectives );
+}
+
+inline bool solution_store::single_source() const
+{
+	return _single_source;
+}
+
+inline const double * solution_store::point( int index ) const
+{
+	return &_points[(std::size_t)index * _instance.num_objectives];
+}
+
+inline bool solution_store::open( int index, int j ) const
+{
+	return ( _open[index * _bitset_size + j / 8] >> ( j % 8 ) ) & 1;
+}
+
+inline int solution_store::facility( int index, int i ) const
+{
+	return (int)_facility[(std::size_t)index * _instance.num_customers + i];
+}
+
+inline std::size_t solution_store::customer_begin( int index, int i ) const
+{
+	return _start[(std::size_t)index * _instance.num_customers + i];
+}
+
+#endif
@@ -0,0 +1,170 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef THREAD_HPP
+#define THREAD_HPP
+
+#include <pthread.h>
+
+/*
+	Class: mutex
+
+	A thin wrapper around a POSIX mutex.
+*/
+class mutex
+{
+public:
+	/*
+		Constructor: mutex
+	*/
+	mutex();
+
+	/*
+		Destructor: mutex
+	*/
+	~mutex();
+
+	/*
+		Method: lock
+	*/
+	void lock();
+
+	/*
+		Method: unlock
+	*/
+	void unlock();
+
+private:
+	pthread_mutex_t _mutex;
+
+	friend class condition;
+
+	// Non copyable
+	mutex( const mutex & );
+	mutex & operator = ( const mutex & );
+};
+
+/*
+	Class: lock_guard
+
+	Lock a mutex for the lifetime of the object.
+*/
+class lock_guard
+{
+public:
+	/*
+		Constructor: lock_guard
+	*/
+	explicit lock_guard( mutex & m );
+
+	/*
+		Destructor: lock_guard
+	*/
+	~lock_guard();
+
+private:
+	mutex & _mutex;
+
+	// Non copyable
+	lock_guard( const lock_guard & );
+	lock_guard & operator = ( const lock_guard & );
+};
+
+/*
+	Class: condition
+
+	A thin wrapper around a POSIX condition variable.
+*/
+class condition
+{
+public:
+	/*
+		Constructor: condition
+	*/
+	condition();
+
+	/*
+		Destructor: condition
+	*/
+	~condition();
+
+	/*
+		Method: wait
+
+		Atomically release the mutex and wait for a notification.
+		The mutex must be locked by the calling thread.
+	*/
+	void wait( mutex & m );
+
+	/*
+		Method: notify_all
+	*/
+	void notify_all();
+
+private:
+	pthread_cond_t _cond;
+
+	// Non copyable
+	condition( const condition & );
+	condition & operator = ( const condition & );
+};
+
+/*
+	Function: run_threads
+
+	Run a routine on a pool of threads and wait for all of them to finish.
+	With only one thread, the routine is run in the calling thread.
+
+	Parameters:
+		num_threads - The number of threads.
+		routine - The function executed by every thread.
+		arg - The argument given to the routine.
+*/
+void run_threads( int num_threads, void * (*routine)( void * ), void * arg );
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline void mutex::lock()
+{
+	pthread_mutex_lock( &_mutex );
+}
+
+inline void mutex::unlock()
+{
+	pthread_mutex_unlock( &_mutex );
+}
+
+inline lock_guard::lock_guard( mutex & m ) :
+	_mutex( m )
+{
+	_mutex.lock();
+}
+
+inline lock_guard::~lock_guard()
+{
+	_mutex.unlock();
+}
+
+inline void condition::wait( mutex & m )
+{
+	pthread_cond_wait( &_cond, &m._mutex );
+}
+
+inline void condition::notify_all()
+{
+	pthread_cond_broadcast( &_cond );
+}
+
+#endif
@@ -0,0 +1,60 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TIMER_HPP
+#define TIMER_HPP
+
+/*
+	Class: timer
+
+	Measure wall clock time. Unlike std::clock, the time spent by other
+	threads is not counted.
+*/
+class timer
+{
+public:
+	/*
+		Constructor: timer
+
+		Create a timer and start it.
+	*/
+	timer();
+
+	/*
+		Method: restart
+	*/
+	void restart();
+
+	/*
+		Method: elapsed
+
+		Returns:
+			The number of seconds since the last start.
+	*/
+	double elapsed() const;
+
+	/*
+		Function: now
+
+		Returns:
+			The current wall clock time in seconds.
+	*/
+	static double now();
+
+private:
+	double _start;
+};
+
+#endif
@@ -0,0 +1,107 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include "thread.hpp"
+#include <string>
+#include <vector>
+
+/*
+	Class: trace_record
+
+	Measures of one solve of a flp_solver.
+*/
+struct trace_record
+{
+	const char * scalarization;   // "weighted_sum" or "epsilon_constraint"
+	double lambda;                // Weight of a weighted sum
+	double epsilon, lower;        // Bounds of an epsilon-constraint
+	std::vector<double> epsilons; // Upper bounds of all objectives if more than two
+	double presolve_time;         // Wall clock times in seconds
+	double solve_time;
+	double dual_time;             // Time spent in store_dual
+	double free_time;             // Time spent freeing the transformed problem
+	long nodes;
+	long lp_iterations;
+	double gap;
+	double dual_bound;
+	const char * status;
+	std::vector<double> objectives;   // Empty if no solution was found
+
+	trace_record();
+};
+
+/*
+	Class: trace_writer
+
+	Write trace_record as JSON lines to a file. Records can be written by
+	several threads, each record being written at once.
+*/
+class trace_writer
+{
+public:
+	/*
+		Constructor: trace_writer
+
+		Open a file, see <open>.
+	*/
+	explicit trace_writer( const std::string & filename );
+
+	/*
+		Constructor: trace_writer
+
+		Write to an open file descriptor, which is not closed.
+	*/
+	explicit trace_writer( int fd );
+
+	/*
+		Destructor: trace_writer
+	*/
+	~trace_writer();
+
+	/*
+		Method: open
+
+		Truncate and open a file. "-" is the standard output and "fd:<n>" the
+		file descriptor n. Throw std::runtime_error on failure.
+	*/
+	void open( const std::string & filename );
+
+	/*
+		Method: close
+	*/
+	void close();
+
+	/*
+		Method: write
+
+		Write a record on one line, with the peak resident set size of the
+		process. Throw std::runtime_error on failure.
+	*/
+	void write( const trace_record & record );
+
+private:
+	int _fd;
+	bool _owned;   // Whether _fd must be closed
+	mutex _lock;   // Protect _fd
+
+	// Non copyable
+	trace_writer( const trace_writer & );
+	trace_writer & operator = ( const trace_writer & );
+};
+
+#endif
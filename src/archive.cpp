@@ -0,0 +1,147 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "archive.hpp"
+#include <algorithm>
+
+archive::archive( int dimension ) :
+	_dimension( dimension ),
+	_points()
+{
+}
+
+bool archive::insert( const double * z )
+{
+	int p = _dimension;
+
+	if ( is_dominated( z ) )
+		return false;
+
+	// Points dominated by z are lexicographically greater than z
+	int first = lower_bound( z ), last = first;
+
+	if ( p == 2 )
+	{
+		// The second objective is decreasing: dominated points are contiguous
+		while ( last < size() && (*this)[last][1] >= z[1] )
+			++last;
+
+		_points.erase( _points.begin() + (std::size_t)first * p, _points.begin() + (std::size_t)last * p );
+	}
+	else
+	{
+		// Compact the points after z which are not dominated
+		int kept = first;
+		for ( last = first; last < size(); ++last )
+		{
+			if ( !dominates( z, (*this)[last] ) )
+			{
+				if ( kept != last )
+					std::copy( (*this)[last], (*this)[last] + p, _points.begin() + (std::size_t)kept * p );
+				++kept;
+			}
+		}
+		_points.resize( (std::size_t)kept * p );
+	}
+
+	_points.insert( _points.begin() + (std::size_t)first * p, z, z + p );
+	return true;
+}
+
+bool archive::is_dominated( const double * z ) const
+{
+	// Points dominating z are lexicographically less than or equal to z
+	int last = upper_bound( z );
+
+	if ( _dimension == 2 )
+	{
+		// The last of them has the smallest second objective
+		return last > 0 && (*this)[last-1][1] <= z[1];
+	}
+
+	for ( int q = 0; q < last; ++q )
+	{
+		if ( dominates( (*this)[q], z ) )
+			return true;
+	}
+	return false;
+}
+
+void archive::point( int index, std::vector<double> & z ) const
+{
+	z.assign( (*this)[index], (*this)[index] + _dimension );
+}
+
+int archive::lower_bound( const double * z ) const
+{
+	int first = 0, count = size();
+
+	while ( count > 0 )
+	{
+		int step = count / 2, middle = first + step;
+		if ( less( (*this)[middle], z ) )
+		{
+			first = middle + 1;
+			count -= step + 1;
+		}
+		else
+		{
+			count = step;
+		}
+	}
+	return first;
+}
+
+int archive::upper_bound( const double * z ) const
+{
+	int first = 0, count = size();
+
+	while ( count > 0 )
+	{
+		int step = count / 2, middle = first + step;
+		if ( !less( z, (*this)[middle] ) )
+		{
+			first = middle + 1;
+			count -= step + 1;
+		}
+		else
+		{
+			count = step;
+		}
+	}
+	return first;
+}
+
+bool archive::dominates( const double * a, const double * b ) const
+{
+	for ( int k = 0; k < _dimension; ++k )
+	{
+		if ( a[k] > b[k] )
+			return false;
+	}
+	return true;
+}
+
+bool archive::less( const double * a, const double * b ) const
+{
+	for ( int k = 0; k < _dimension; ++k )
+	{
+		if ( a[k] < b[k] )
+			return true;
+		if ( a[k] > b[k] )
+			return false;
+	}
+	return false;
+}
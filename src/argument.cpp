@@ -22,19 +22,44 @@
 int argument::capacitated( 1 );
 int argument::single_source( 1 );
 int argument::relaxation( 0 );
+int argument::lazy_opening( 0 );
 int argument::lexicographic( 0 );
 int argument::weighted_sum( 0 );
 int argument::supported( 0 );
 int argument::efficient( 1 );
 int argument::objective( 0 );
+int argument::objectives( 2 );
 int argument::display_solution( 0 );
 int argument::verblevel( 0 );
 int argument::verbose( 1 );
+int argument::threads( 1 );
+int argument::slabs( 0 );
+int argument::jobs( 1 );
+int argument::serve( 0 );
+int argument::node_limit( -1 );
+int argument::warm_start( 1 );
+int argument::reopt( 0 );
+int argument::harvest( 0 );
+int argument::heuristic( 1 );
+int argument::lagrangian( 0 );
+int argument::resume( 0 );
+int argument::convert( 0 );
 int argument::help( 0 );
 double argument::lambda( 0. );
 double argument::from( std::numeric_limits<double>::infinity() );
 double argument::step( 1 );
+double argument::augmented( 0. );
+double argument::checkpoint_interval( 60. );
+double argument::time_limit( std::numeric_limits<double>::infinity() );
 std::string argument::filename;
+std::vector<std::string> argument::filenames;
+std::string argument::batch_file;
+std::string argument::serve_address;
+std::string argument::output_format;
+std::string argument::solutions_file;
+std::string argument::destination;
+std::string argument::trace_file;
+std::string argument::checkpoint_file;
 
 // getopt long options array
 static const struct option long_options[] = {
@@ -43,16 +68,40 @@ static const struct option long_options[] = {
 	{ "single-source",    no_argument,       &argument::single_source,    1   },
 	{ "multi-source",     no_argument,       &argument::single_source,    0   },
 	{ "relaxation",       no_argument,       &argument::relaxation,       1   },
+	{ "lazy-opening",     no_argument,       &argument::lazy_opening,     1   },
 	{ "lexicographic",    optional_argument, 0,                           'l' },
 	{ "weighted-sum",     required_argument, 0,                           'w' },
 	{ "supported",        no_argument,       &argument::supported,        1   },
 	{ "efficient",        optional_argument, 0,                           'e' },
 	{ "from",             required_argument, 0,                           'f' },
+	{ "objectives",       required_argument, 0,                           argument::id_objectives },
 	{ "step",             required_argument, 0,                           argument::id_step },
+	{ "augmented",        optional_argument, 0,                           argument::id_augmented },
+	{ "warm-start",       no_argument,       &argument::warm_start,       1   },
+	{ "cold-start",       no_argument,       &argument::warm_start,       0   },
+	{ "reopt",            no_argument,       &argument::reopt,            1   },
+	{ "harvest",          no_argument,       &argument::harvest,          1   },
+	{ "flp-heuristic",    no_argument,       &argument::heuristic,        1   },
+	{ "no-flp-heuristic", no_argument,       &argument::heuristic,        0   },
+	{ "lagrangian",       optional_argument, 0,                           argument::id_lagrangian },
+	{ "convert",          no_argument,       &argument::convert,          1   },
+	{ "output",           required_argument, 0,                           argument::id_output },
+	{ "solutions",        required_argument, 0,                           argument::id_solutions },
 	{ "display-solution", no_argument,       &argument::display_solution, 1   },
 	{ "verblevel",        required_argument, 0,                           'v' },
 	{ "verbose",          optional_argument, 0,                           'v' },
 	{ "quiet",            no_argument,       &argument::verbose,          0   },
+	{ "threads",          required_argument, 0,                           argument::id_threads },
+	{ "slabs",            required_argument, 0,                           argument::id_slabs },
+	{ "trace",            required_argument, 0,                           argument::id_trace },
+	{ "checkpoint",       required_argument, 0,                           argument::id_checkpoint },
+	{ "checkpoint-interval", required_argument, 0,                        argument::id_checkpoint_interval },
+	{ "resume",           no_argument,       &argument::resume,           1   },
+	{ "time-limit",       required_argument, 0,                           argument::id_time_limit },
+	{ "node-limit",       required_argument, 0,                           argument::id_node_limit },
+	{ "batch",            required_argument, 0,                           argument::id_batch },
+	{ "jobs",             required_argument, 0,                           argument::id_jobs },
+	{ "serve",            optional_argument, 0,                           argument::id_serve },
 	{ "help",             no_argument,       &argument::help,             1   },
 	{ 0, 0, 0, 0 }
 };
@@ -119,6 +168,75 @@ void argument::parse( int argc, char *argv[] )
 				std::istringstream( optarg ) >> step;
 				break;
 
+			case argument::id_augmented:
+				augmented = 1e-3;
+				if ( optarg )
+				{
+					std::istringstream( optarg ) >> augmented;
+				}
+				break;
+
+			case argument::id_objectives:
+				std::istringstream( optarg ) >> objectives;
+				break;
+
+			case argument::id_threads:
+				std::istringstream( optarg ) >> threads;
+				break;
+
+			case argument::id_slabs:
+				std::istringstream( optarg ) >> slabs;
+				break;
+
+			case argument::id_trace:
+				trace_file = optarg;
+				break;
+
+			case argument::id_checkpoint:
+				checkpoint_file = optarg;
+				break;
+
+			case argument::id_checkpoint_interval:
+				std::istringstream( optarg ) >> checkpoint_interval;
+				break;
+
+			case argument::id_batch:
+				batch_file = optarg;
+				break;
+
+			case argument::id_jobs:
+				std::istringstream( optarg ) >> jobs;
+				break;
+
+			case argument::id_output:
+				output_format = optarg;
+				break;
+
+			case argument::id_solutions:
+				solutions_file = optarg;
+				break;
+
+			case argument::id_lagrangian:
+				lagrangian = 200;
+				if ( optarg )
+				{
+					std::istringstream( optarg ) >> lagrangian;
+				}
+				break;
+
+			case argument::id_serve:
+				serve = 1;
+				serve_address = ( optarg ? optarg : "" );
+				break;
+
+			case argument::id_time_limit:
+				std::istringstream( optarg ) >> time_limit;
+				break;
+
+			case argument::id_node_limit:
+				std::istringstream( optarg ) >> node_limit;
+				break;
+
 			case 'v':
 				verbose = 1;
 				if ( optarg )
@@ -145,11 +263,23 @@ void argument::parse( int argc, char *argv[] )
 	}
 	while ( next_option != -1 );
 
+	filenames.assign( argv + optind, argv + argc );
+
 	if ( optind < argc )
 	{
 		filename = argv[optind];
 	}
 
+	if ( optind + 1 < argc )
+	{
+		destination = argv[optind + 1];
+	}
+
+	if ( convert && destination.empty() )
+	{
+		filename.clear();
+	}
+
 	if ( lexicographic )
 	{
 		weighted_sum = 0;
@@ -172,17 +302,46 @@ void argument::parse( int argc, char *argv[] )
 	{
 		verblevel = 0;
 	}
+
+	if ( threads < 1 )
+	{
+		threads = 1;
+	}
+
+	if ( objectives < 2 )
+	{
+		objectives = 2;
+	}
+
+	if ( jobs < 1 )
+	{
+		jobs = 1;
+	}
 }
 
 void argument::print( std::ostream & os )
 {
+	os << "File:";
+	for ( std::size_t index = 0; index < filenames.size(); ++index )
+	{
+		os << ' ' << filenames[index];
+	}
+	os << std::endl;
+
+	if ( !batch_file.empty() )
+	{
+		os
+			<< "Batch: " << batch_file << std::endl;
+	}
+
 	os
-		<< "File: " << filename << std::endl
 		<< "Options:" << std::endl
 		<< std::boolalpha
 		<< "\tcapacitated      = " << (bool)capacitated   << std::endl
 		<< "\tsingle-source    = " << (bool)single_source << std::endl
+		<< "\tobjectives       = " << objectives          << std::endl
 		<< "\trelaxation       = " << (bool)relaxation    << std::endl
+		<< "\tlazy-opening     = " << (bool)lazy_opening  << std::endl
 		<< "\tlexicographic    = " << (bool)lexicographic << std::endl
 		<< "\tweighted-sum     = " << (bool)weighted_sum  << std::endl
 		<< "\tsupported        = " << (bool)supported     << std::endl
@@ -210,10 +369,78 @@ void argument::print( std::ostream & os )
 	{
 		os
 			<< "\tfrom             = " << from << std::endl
-			<< "\tstep             = " << step << std::endl;
+			<< "\tstep             = " << step << std::endl
+			<< "\taugmented        = " << augmented << std::endl;
+	}
+
+	if ( supported || efficient )
+	{
+		os
+			<< "\tthreads          = " << threads << std::endl;
+	}
+
+	if ( efficient && threads > 1 )
+	{
+		os
+			<< "\tslabs            = " << ( slabs > 0 ? slabs : threads ) << std::endl;
+	}
+
+	if ( !trace_file.empty() )
+	{
+		os
+			<< "\ttrace            = " << trace_file << std::endl;
+	}
+
+	if ( !batch_file.empty() || filenames.size() > 1 )
+	{
+		os
+			<< "\tjobs             = " << jobs << std::endl;
+	}
+
+	if ( serve )
+	{
+		os
+			<< "\tserve            = " << ( serve_address.empty() ? "stdin/stdout" : serve_address ) << std::endl;
+	}
+
+	if ( !checkpoint_file.empty() )
+	{
+		os
+			<< "\tcheckpoint       = " << checkpoint_file << std::endl
+			<< "\tinterval         = " << checkpoint_interval << std::endl
+			<< "\tresume           = " << (bool)resume << std::endl;
+	}
+
+	if ( time_limit < std::numeric_limits<double>::infinity() )
+	{
+		os
+			<< "\ttime-limit       = " << time_limit << std::endl;
+	}
+
+	if ( node_limit >= 0 )
+	{
+		os
+			<< "\tnode-limit       = " << node_limit << std::endl;
+	}
+
+	if ( !output_format.empty() )
+	{
+		os
+			<< "\toutput           = " << output_format << std::endl;
+	}
+
+	if ( !solutions_file.empty() )
+	{
+		os
+			<< "\tsolutions        = " << solutions_file << std::endl;
 	}
 
 	os
+		<< "\twarm-start       = " << (bool)warm_start       << std::endl
+		<< "\treopt            = " << (bool)reopt            << std::endl
+		<< "\tharvest          = " << (bool)harvest          << std::endl
+		<< "\tflp-heuristic    = " << (bool)heuristic        << std::endl
+		<< "\tlagrangian       = " << lagrangian             << std::endl
 		<< "\tdisplay-solution = " << (bool)display_solution << std::endl
 		<< "\tverbose          = " << (bool)verbose          << std::endl;
 
@@ -228,11 +455,17 @@ void argument::usage( const char * program_name, std::ostream & os )
 {
 	os
 		<< "Usage: " << program_name << " [OPTIONS] <instance>" << std::endl
+		<< "       " << program_name << " [OPTIONS] <instance> <instance>..." << std::endl
+		<< "       " << program_name << " [OPTIONS] --batch <manifest> [<instance>...]" << std::endl
+		<< "       " << program_name << " [OPTIONS] --serve[=<socket>]" << std::endl
+		<< "       " << program_name << " [OPTIONS] --convert <instance> <binary>" << std::endl
 		<< "Options:" << std::endl
 		<< "\t-u,--uncapacitated     for uncapacitated facility location"   << std::endl
 		<< "\t-c,--capacitated       for capacitated facility location"     << std::endl
 		<< "\t-m,--multi-source      for multi source facility location"    << std::endl
 		<< "\t-r,--relaxation        for relaxed problem"                   << std::endl
+		<< "\t   --objectives <p>    number of objectives (default 2)"      << std::endl
+		<< "\t   --lazy-opening      to separate x(i,j) <= y(j) on demand"  << std::endl
 		<< "\t-l,--lexicographic     to get lexicographic solutions"        << std::endl
 		<< "\t   --lexicographic=<k> to compute only for objective k"       << std::endl
 		<< "\t-w,--weighted-sum <w>  to get a solution of a weighted sum"   << std::endl
@@ -241,10 +474,67 @@ void argument::usage( const char * program_name, std::ostream & os )
 		<< "\t   --efficient=<k>     to set objective k as main objective"  << std::endl
 		<< "\t-f,--from <epsilon>    starting value for epsilon-constraint" << std::endl
 		<< "\t   --step <delta>      step value for epsilon-constraint"     << std::endl
+		<< "\t   --augmented[=<d>]   augmented epsilon-constraint (d=1e-3)" << std::endl
+		<< "\t   --threads <n>       number of threads for supported/efficient"  << std::endl
+		<< "\t   --slabs <k>         number of slabs for parallel efficient"   << std::endl
+		<< "\t   --cold-start        to disable warm start between solves"   << std::endl
+		<< "\t   --reopt             to use SCIP reoptimization"             << std::endl
+		<< "\t   --no-flp-heuristic  to disable the facility location heuristic" << std::endl
+		<< "\t   --lagrangian[=<n>]  Lagrangian bounds to skip solves (n=200)" << std::endl
+		<< "\t   --harvest           to keep all the solutions found by SCIP"  << std::endl
+		<< "\t                       as cutoffs and to fill stopped fronts"  << std::endl
+		<< "\t   --convert           to convert an instance to binary format" << std::endl
+		<< "\t                       (with -u: without demands nor capacities)" << std::endl
+		<< "\t   --trace <file>      to write a JSON line per solve (- or fd:<n>)" << std::endl
+		<< "\t   --checkpoint <file> to save the state of the method"         << std::endl
+		<< "\t   --checkpoint-interval <s> seconds between two saves (60)"    << std::endl
+		<< "\t   --resume            to resume from the checkpoint"          << std::endl
+		<< "\t   --time-limit <s>    wall time budget for all the solves"     << std::endl
+		<< "\t   --node-limit <n>    node budget for all the solves"          << std::endl
+		<< "\t   --batch <manifest>  instances to solve, one per line"       << std::endl
+		<< "\t                       with an optional method"              << std::endl
+		<< "\t   --jobs <n>          number of instances solved at a time"  << std::endl
+		<< "\t   --serve[=<socket>]  to answer solve requests (JSON lines)"  << std::endl
+		<< "\t   --output <format>   to stream the points (ndjson, csv, bin)" << std::endl
+		<< "\t   --solutions <file>  to save the solutions of the front"     << std::endl
 		<< "\t   --display-solution  to display x and y values"             << std::endl
+		<< "\t                       (with --output: write the solutions)"  << std::endl
 		<< "\t-q,--quiet             for quiet mode"                        << std::endl
 		<< "\t-v,--verbose           for verbose mode"                      << std::endl
 		<< "\t   --verblevel <lv>    SCIP verbosity level"                  << std::endl
 		<< "\t-h,--help              to display this help"                  << std::endl;
 }
 
+std::string argument::identity()
+{
+	std::ostringstream os;
+
+	// sequential and parallel methods save different tasks
+	os.precision( 17 );
+	os
+		<< "capacitated=" << capacitated
+		<< " single-source=" << single_source
+		<< " relaxation=" << relaxation
+		<< " objectives=" << objectives
+		<< " supported=" << supported
+		<< " efficient=" << efficient
+		<< " objective=" << objective
+		<< " from=" << from
+		<< " step=" << step
+		<< " augmented=" << augmented
+		<< " parallel=" << ( threads > 1 );
+
+	return os.str();
+}
+
+std::string argument::method()
+{
+	if ( lexicographic )
+		return "lexicographic";
+	if ( weighted_sum )
+		return "weighted-sum";
+	if ( supported )
+		return "supported";
+	return "efficient";
+}
+
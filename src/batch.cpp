@@ -0,0 +1,220 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "batch.hpp"
+#include "problem.hpp"
+#include "flp_solver.hpp"
+#include "argument.hpp"
+#include "archive.hpp"
+#include "methods.hpp"
+#include "reader.hpp"
+#include "budget.hpp"
+#include "lower_bound_set.hpp"
+#include "candidate_pool.hpp"
+#include "thread.hpp"
+#include "timer.hpp"
+#include "json.hpp"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+/*
+	Class: batch_context
+
+	State shared by the threads of the batch mode.
+*/
+struct batch_context
+{
+	const std::vector<batch_job> & jobs;
+	trace_writer * trace;
+	std::ostream & os;
+	std::size_t next_job;   // Index of the next job to solve
+	mutex lock;             // Protect next_job and os
+
+	batch_context( const std::vector<batch_job> & jobs, trace_writer * trace, std::ostream & os ) :
+		jobs( jobs ), trace( trace ), os( os ), next_job( 0 ) {}
+};
+
+/*
+	Function: batch_worker
+
+	Solve jobs of a batch_context until none are left.
+
+	Parameters:
+		arg - A pointer to a batch_context.
+*/
+static void * batch_worker( void * arg );
+
+/*
+	Function: solve_job
+
+	Solve a job and write its result as a JSON line.
+*/
+static std::string solve_job( const batch_job & job, trace_writer * trace );
+
+////////////////////////////////////////////////////////////////////////////////
+
+void read_manifest( const std::string & filename, const std::string & method, std::vector<batch_job> & jobs )
+{
+	std::ifstream file( filename.c_str() );
+	std::string line;
+
+	if ( !file )
+		throw std::runtime_error( "unable to open " + filename );
+
+	while ( std::getline( file, line ) )
+	{
+		std::istringstream is( line );
+		std::string instance, job_method;
+
+		if ( !( is >> instance ) || instance[0] == '#' )
+			continue;
+
+		if ( !( is >> job_method ) )
+			job_method = method;
+
+		if ( job_method != "lexicographic" && job_method != "weighted-sum"
+			&& job_method != "supported" && job_method != "efficient" )
+			throw std::runtime_error( filename + ": unknown method " + job_method );
+
+		jobs.push_back( batch_job( instance, job_method ) );
+	}
+}
+
+void run_batch( const std::vector<batch_job> & jobs, int num_jobs, trace_writer * trace, std::ostream & os )
+{
+	batch_context context( jobs, trace, os );
+
+	if ( num_jobs > (int)jobs.size() )
+		num_jobs = (int)jobs.size();
+
+	if ( num_jobs > 1 )
+		run_threads( num_jobs, batch_worker, &context );
+	else
+		batch_worker( &context );
+}
+
+void * batch_worker( void * arg )
+{
+	batch_context & context = *static_cast<batch_context *>( arg );
+
+	for ( ;; )
+	{
+		std::size_t index;
+
+		{
+			lock_guard guard( context.lock );
+			if ( context.next_job >= context.jobs.size() )
+				break;
+			index = context.next_job++;
+		}
+
+		std::string line = solve_job( context.jobs[index], context.trace );
+
+		lock_guard guard( context.lock );
+		context.os << line;
+		context.os.flush();
+	}
+
+	return 0;
+}
+
+std::string solve_job( const batch_job & job, trace_writer * trace )
+{
+	std::ostringstream os;
+	archive pareto_front;
+	solver_statistics statistics;
+	double build_time( 0. ), wall_time( 0. );
+	std::string status( "complete" ), error;
+	timer wall;
+
+	try
+	{
+		problem instance( argument::objectives, (bool)argument::capacitated, (bool)argument::single_source );
+		mapped_file file;
+
+		load_instance( job.filename, file, instance );
+
+		// each job has its own budget, the signals stop all of them
+		budget limits( argument::time_limit, argument::node_limit );
+		lower_bound_set bounds;
+		candidate_pool candidates( instance.num_objectives );
+
+		flp_solver solve( instance, argument::relaxation, argument::lazy_opening );
+		solve.set_verblevel( argument::verblevel );
+		solve.set_warm_start( argument::warm_start );
+		solve.set_reoptimization( argument::reopt );
+		solve.set_dual_extraction( argument::relaxation );
+		solve.set_heuristic( argument::heuristic );
+		solve.set_trace( trace );
+		solve.set_budget( &limits );
+		solve.set_lower_bound_set( &bounds );
+		if ( argument::harvest )
+			solve.set_candidate_pool( &candidates );
+		build_time = solve.get_build_time();
+
+		pareto_front = run_method( solve, job.method );
+		statistics = solve.statistics();
+
+		if ( limits.exhausted() )
+		{
+			status = limits.reason();
+
+			// the points of a stopped front are not all proven efficient
+			if ( argument::harvest )
+				candidates.merge( pareto_front );
+		}
+	}
+	catch ( const std::exception & e )
+	{
+		status = "error";
+		error = e.what();
+	}
+
+	wall_time = wall.elapsed();
+
+	// objective values need more than 6 digits
+	os.precision( 15 );
+	os << "{\"instance\":";
+	write_json_string( os, job.filename );
+	os << ",\"method\":";
+	write_json_string( os, job.method );
+	os << ",\"status\":";
+	write_json_string( os, status );
+
+	if ( !error.empty() )
+	{
+		os << ",\"error\":";
+		write_json_string( os, error );
+	}
+
+	os
+		<< ",\"build_time\":" << build_time
+		<< ",\"wall_time\":" << wall_time
+		<< ",\"solves\":" << statistics.solves
+		<< ",\"nodes\":" << statistics.nodes
+		<< ",\"lp_iterations\":" << statistics.lp_iterations
+		<< ",\"points\":[";
+
+	for ( int index = 0; index < pareto_front.size(); ++index )
+	{
+		if ( index > 0 )
+			os << ',';
+		write_json_array( os, pareto_front[index], pareto_front.dimension() );
+	}
+
+	os << "]}\n";
+	return os.str();
+}
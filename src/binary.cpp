@@ -0,0 +1,160 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "binary.hpp"
+#include <fstream>
+#include <stdexcept>
+#include <numeric>
+#include <limits>
+#include <cstring>
+#include <vector>
+
+static const char binary_magic[8] = { 'M', 'O', 'F', 'L', 'P', 'B', 'I', 'N' };
+
+// Round an offset up to the alignment of the arrays
+static std::size_t align( std::size_t offset )
+{
+	return ( offset + binary_header::alignment - 1 ) / binary_header::alignment * binary_header::alignment;
+}
+
+// Write an array of doubles, padded to the alignment of the arrays
+static void write_array( std::ofstream & os, const double * data, std::size_t size )
+{
+	static const char zeros[binary_header::alignment] = { 0 };
+	std::size_t bytes = size * sizeof( double );
+
+	os.write( reinterpret_cast<const char *>( data ), bytes );
+	os.write( zeros, align( bytes ) - bytes );
+}
+
+bool is_binary_instance( const mapped_file & file )
+{
+	return file.size() >= sizeof( binary_header )
+		&& std::memcmp( file.data(), binary_magic, sizeof( binary_magic ) ) == 0;
+}
+
+void map_binary_instance( const mapped_file & file, problem & instance )
+{
+	binary_header header;
+
+	if ( !is_binary_instance( file ) )
+		throw std::runtime_error( "not a binary instance" );
+
+	std::memcpy( &header, file.data(), sizeof( header ) );
+
+	if ( header.byte_order != binary_header::byte_order_mark )
+		throw std::runtime_error( "binary instance written with another byte order" );
+
+	if ( header.version != binary_header::current_version )
+		throw std::runtime_error( "unsupported binary instance version" );
+
+	if ( header.cost_type != binary_header::cost_double )
+		throw std::runtime_error( "unsupported binary instance cost type" );
+
+	if ( (int)header.num_objectives != instance.num_objectives )
+		throw std::runtime_error( "binary instance has another number of objectives" );
+
+	if ( instance.capacitated && !header.capacitated )
+		throw std::runtime_error( "binary instance has no demands nor capacities" );
+
+	std::size_t p = header.num_objectives, m = header.num_customers, n = header.num_facilities;
+	std::size_t limit = file.size() / sizeof( double );
+
+	if ( m == 0 || n == 0 || m > (std::size_t)std::numeric_limits<int>::max()
+		|| n > (std::size_t)std::numeric_limits<int>::max() )
+		throw std::runtime_error( "invalid size in binary instance" );
+
+	// The costs cannot be larger than the file, which bounds the products
+	if ( m > limit / p || p * m > limit / n )
+		throw std::runtime_error( "truncated binary instance" );
+
+	std::size_t offset_c = align( sizeof( header ) );
+	std::size_t offset_f = offset_c + align( p * m * n * sizeof( double ) );
+	std::size_t offset_d = offset_f + align( p * n * sizeof( double ) );
+	std::size_t offset_q = offset_d + align( m * sizeof( double ) );
+	std::size_t end = header.capacitated ? offset_q + n * sizeof( double ) : offset_d;
+
+	if ( file.size() < end )
+		throw std::runtime_error( "truncated binary instance" );
+
+	const double * c = reinterpret_cast<const double *>( file.data() + offset_c );
+	const double * f = reinterpret_cast<const double *>( file.data() + offset_f );
+	const double * d = reinterpret_cast<const double *>( file.data() + offset_d );
+	const double * q = reinterpret_cast<const double *>( file.data() + offset_q );
+
+	instance.num_customers = m;
+	instance.num_facilities = n;
+
+	// The mapping is read-only, costs must not be modified
+	instance.costs.borrow( const_cast<double *>( c ), p * m * n );
+
+	instance.f.resize( p );
+	for ( std::size_t k = 0; k < p; ++k )
+	{
+		instance.f[k].assign( f + k * n, f + ( k + 1 ) * n );
+	}
+
+	instance.D = 0.;
+	instance.Q = std::numeric_limits<double>::infinity();
+	instance.d.assign( m, 0 );
+	instance.q.assign( n, std::numeric_limits<double>::infinity() );
+
+	if ( instance.capacitated )
+	{
+		instance.d.assign( d, d + m );
+		instance.q.assign( q, q + n );
+		instance.D = std::accumulate( d, d + m, 0. );
+		instance.Q = std::accumulate( q, q + n, 0. );
+	}
+}
+
+void write_binary_instance( const std::string & filename, const problem & instance )
+{
+	binary_header header;
+	std::ofstream os( filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc );
+
+	if ( !os.is_open() )
+		throw std::runtime_error( "unable to open '" + filename + "'" );
+
+	std::memset( &header, 0, sizeof( header ) );
+	std::memcpy( header.magic, binary_magic, sizeof( binary_magic ) );
+	header.version = binary_header::current_version;
+	header.byte_order = binary_header::byte_order_mark;
+	header.num_objectives = instance.num_objectives;
+	header.num_customers = instance.num_customers;
+	header.num_facilities = instance.num_facilities;
+	header.capacitated = instance.capacitated ? 1 : 0;
+	header.cost_type = binary_header::cost_double;
+
+	os.write( reinterpret_cast<const char *>( &header ), sizeof( header ) );
+
+	write_array( os, instance.costs.data(), instance.costs.size() );
+
+	std::vector<double> f;
+	for ( int k = 0; k < instance.num_objectives; ++k )
+	{
+		f.insert( f.end(), instance.f[k].begin(), instance.f[k].end() );
+	}
+	write_array( os, &f[0], f.size() );
+
+	if ( instance.capacitated )
+	{
+		write_array( os, &instance.d[0], instance.num_customers );
+		write_array( os, &instance.q[0], instance.num_facilities );
+	}
+
+	if ( !os )
+		throw std::runtime_error( "unable to write '" + filename + "'" );
+}
@@ -0,0 +1,72 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "budget.hpp"
+#include "timer.hpp"
+#include <limits>
+#include <algorithm>
+
+volatile std::sig_atomic_t budget::_signaled( 0 );
+
+budget::budget( double time_limit, long node_limit ) :
+	_deadline( timer::now() + time_limit ),
+	_nodes( node_limit )
+{
+}
+
+bool budget::exhausted() const
+{
+	return reason() != 0;
+}
+
+double budget::time_left() const
+{
+	return std::max( 0., _deadline - timer::now() );
+}
+
+long budget::nodes_left() const
+{
+	lock_guard guard( _lock );
+	return _nodes;
+}
+
+void budget::consume_nodes( long nodes )
+{
+	lock_guard guard( _lock );
+	if ( _nodes >= 0 )
+		_nodes = std::max( 0L, _nodes - nodes );
+}
+
+const char * budget::reason() const
+{
+	if ( signaled() )
+		return "interrupted";
+	if ( time_left() <= 0. )
+		return "time limit";
+	if ( nodes_left() == 0 )
+		return "node limit";
+	return 0;
+}
+
+void budget::catch_signals()
+{
+	std::signal( SIGINT, handler );
+	std::signal( SIGTERM, handler );
+}
+
+void budget::handler( int )
+{
+	_signaled = 1;
+}
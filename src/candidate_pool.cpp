@@ -0,0 +1,88 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "candidate_pool.hpp"
+#include <limits>
+
+candidate_pool::candidate_pool( int dimension ) :
+	_candidates( dimension ),
+	_lock()
+{
+}
+
+bool candidate_pool::insert( const std::vector<double> & z )
+{
+	lock_guard guard( _lock );
+	return _candidates.insert( z );
+}
+
+bool candidate_pool::best( const std::vector<double> & weights, const std::vector<double> & lower,
+	const std::vector<double> & upper, double & value ) const
+{
+	lock_guard guard( _lock );
+
+	int p = _candidates.dimension();
+	bool found = false;
+
+	value = std::numeric_limits<double>::infinity();
+
+	for ( int index = 0; index < _candidates.size(); ++index )
+	{
+		const double * z = _candidates[index];
+		double sum = 0.;
+		bool feasible = true;
+
+		for ( int k = 0; k < p && feasible; ++k )
+		{
+			feasible = ( z[k] >= lower[k] && z[k] <= upper[k] );
+			sum += weights[k] * z[k];
+		}
+
+		if ( feasible && sum < value )
+		{
+			value = sum;
+			found = true;
+		}
+	}
+
+	return found;
+}
+
+int candidate_pool::merge( archive & front ) const
+{
+	lock_guard guard( _lock );
+
+	int inserted = 0;
+
+	for ( int index = 0; index < _candidates.size(); ++index )
+	{
+		if ( front.insert( _candidates[index] ) )
+			++inserted;
+	}
+
+	return inserted;
+}
+
+void candidate_pool::clear()
+{
+	lock_guard guard( _lock );
+	_candidates.clear();
+}
+
+int candidate_pool::size() const
+{
+	lock_guard guard( _lock );
+	return _candidates.size();
+}
@@ -0,0 +1,243 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "checkpoint.hpp"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <limits>
+#include <cstdio>
+#include <cstdlib>
+#include <stdint.h>
+
+/*
+	Function: write_number
+
+	Write a number that can be read back exactly, inf and -inf included.
+*/
+static void write_number( std::ostream & os, double value )
+{
+	if ( value == std::numeric_limits<double>::infinity() )
+		os << "inf";
+	else if ( value == -std::numeric_limits<double>::infinity() )
+		os << "-inf";
+	else
+		os << value;
+}
+
+/*
+	Function: read_number
+
+	Read a number written by write_number.
+*/
+static bool read_number( std::istream & is, double & value )
+{
+	std::string token;
+	char * end;
+
+	if ( !( is >> token ) )
+		return false;
+
+	value = std::strtod( token.c_str(), &end );
+	return *end == '\0';
+}
+
+/*
+	Function: read_vector
+
+	Read a size followed by as many numbers.
+*/
+static bool read_vector( std::istream & is, std::vector<double> & values )
+{
+	std::size_t size;
+
+	if ( !( is >> size ) )
+		return false;
+
+	values.resize( size );
+	for ( std::size_t i = 0; i < size; ++i )
+	{
+		if ( !read_number( is, values[i] ) )
+			return false;
+	}
+	return true;
+}
+
+/*
+	Function: write_vector
+*/
+static void write_vector( std::ostream & os, const std::vector<double> & values )
+{
+	os << values.size();
+	for ( std::size_t i = 0; i < values.size(); ++i )
+	{
+		os << ' ';
+		write_number( os, values[i] );
+	}
+	os << '\n';
+}
+
+/*
+	Function: hash_bytes
+
+	Update a FNV-1a hash.
+*/
+static void hash_bytes( uint64_t & hash, const void * data, std::size_t size )
+{
+	const uint64_t prime = ( (uint64_t)0x100 << 32 ) | 0x1b3;
+	const unsigned char * bytes = static_cast<const unsigned char *>( data );
+
+	for ( std::size_t i = 0; i < size; ++i )
+	{
+		hash ^= bytes[i];
+		hash *= prime;
+	}
+}
+
+checkpoint::checkpoint( const std::string & filename, const std::string & identity, double interval ) :
+	_filename( filename ),
+	_identity( identity ),
+	_interval( interval ),
+	_clock(),
+	_resumed( false ),
+	_points(),
+	_parameters(),
+	_tasks()
+{
+}
+
+bool checkpoint::load()
+{
+	std::ifstream file( _filename.c_str() );
+	std::string magic, identity;
+	std::size_t count;
+	int dimension, version;
+
+	if ( !file )
+		return false;
+
+	file >> magic >> version >> std::ws;
+	if ( magic != "moflp_checkpoint" || version != 1 )
+		throw std::runtime_error( _filename + " is not a checkpoint" );
+
+	std::getline( file, identity );
+	if ( identity != _identity )
+		throw std::runtime_error( _filename + " belongs to another instance or other options" );
+
+	// points
+	if ( !( file >> count >> dimension ) || dimension < 1 )
+		throw std::runtime_error( "invalid checkpoint " + _filename );
+
+	std::vector<double> z( dimension );
+	_points = archive( dimension );
+
+	for ( std::size_t index = 0; index < count; ++index )
+	{
+		for ( int k = 0; k < dimension; ++k )
+		{
+			if ( !read_number( file, z[k] ) )
+				throw std::runtime_error( "invalid checkpoint " + _filename );
+		}
+		_points.insert( z );
+	}
+
+	// parameters and tasks
+	if ( !read_vector( file, _parameters ) || !( file >> count ) )
+		throw std::runtime_error( "invalid checkpoint " + _filename );
+
+	_tasks.resize( count );
+	for ( std::size_t index = 0; index < count; ++index )
+	{
+		if ( !read_vector( file, _tasks[index] ) )
+			throw std::runtime_error( "invalid checkpoint " + _filename );
+	}
+
+	_resumed = true;
+	return true;
+}
+
+void checkpoint::save( const archive & points, const std::vector<double> & parameters,
+	const std::vector< std::vector<double> > & tasks )
+{
+	std::string temporary = _filename + ".tmp";
+
+	{
+		std::ofstream file( temporary.c_str() );
+
+		// enough digits to read the same values back
+		file.precision( std::numeric_limits<double>::digits10 + 2 );
+
+		file << "moflp_checkpoint 1\n" << _identity << '\n';
+		file << points.size() << ' ' << points.dimension() << '\n';
+
+		for ( int index = 0; index < points.size(); ++index )
+		{
+			for ( int k = 0; k < points.dimension(); ++k )
+			{
+				if ( k > 0 )
+					file << ' ';
+				write_number( file, points[index][k] );
+			}
+			file << '\n';
+		}
+
+		write_vector( file, parameters );
+
+		file << tasks.size() << '\n';
+		for ( std::size_t index = 0; index < tasks.size(); ++index )
+		{
+			write_vector( file, tasks[index] );
+		}
+
+		file.flush();
+		if ( !file )
+			throw std::runtime_error( "unable to write " + temporary );
+	}
+
+	// the previous checkpoint remains valid until the new one is complete
+	if ( std::rename( temporary.c_str(), _filename.c_str() ) != 0 )
+		throw std::runtime_error( "unable to write " + _filename );
+
+	_clock.restart();
+}
+
+std::string checkpoint::instance_hash( const problem & instance )
+{
+	uint64_t hash = ( (uint64_t)0xcbf29ce4 << 32 ) | 0x84222325;
+	int header[5] = { instance.num_objectives, instance.num_customers, instance.num_facilities,
+		instance.capacitated, instance.single_source };
+
+	hash_bytes( hash, header, sizeof( header ) );
+	hash_bytes( hash, instance.costs.data(), instance.costs.size() * sizeof( double ) );
+
+	for ( std::size_t k = 0; k < instance.f.size(); ++k )
+	{
+		hash_bytes( hash, &instance.f[k][0], instance.f[k].size() * sizeof( double ) );
+	}
+
+	if ( !instance.d.empty() )
+		hash_bytes( hash, &instance.d[0], instance.d.size() * sizeof( double ) );
+	if ( !instance.q.empty() )
+		hash_bytes( hash, &instance.q[0], instance.q.size() * sizeof( double ) );
+
+	std::ostringstream os;
+	os << std::hex;
+	os.width( 8 );
+	os.fill( '0' );
+	os << (unsigned long)( hash >> 32 );
+	os.width( 8 );
+	os << (unsigned long)( hash & 0xffffffffUL );
+	return os.str();
+}
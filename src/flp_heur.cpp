@@ -0,0 +1,468 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "flp_heur.hpp"
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+#define HEUR_NAME             "flp"
+#define HEUR_DESC             "greedy and local search on the open facilities"
+#define HEUR_DISPCHAR         'F'
+#define HEUR_PRIORITY         100000
+#define HEUR_FREQ             0          // at the root node only
+#define HEUR_FREQOFS          0
+#define HEUR_MAXDEPTH         -1
+#define HEUR_TIMING           SCIP_HEURTIMING_BEFORENODE
+#define HEUR_USESSUBSCIP      FALSE
+
+#define DEFAULT_MAXEVALUATIONS 5000
+
+// Data of the heuristic, the variables are not captured
+struct SCIP_HeurData
+{
+	const problem * instance;
+	std::vector<SCIP_VAR *> vars;             // y(j) then x(i,j)
+	const std::vector<double> * weights;
+	const std::vector<double> * lower;
+	const std::vector<double> * upper;
+	int max_evaluations;
+};
+
+/*
+	Class: candidate
+
+	A set of open facilities and its cheapest assignment.
+*/
+struct candidate
+{
+	std::vector<char> open;
+	std::vector< std::pair<int, double> > assignment;   // Nonzero x(i,j), as (i*n+j, value)
+	double violation;   // Unassigned demand and excess of the epsilon constraints
+	double value;       // Scalarized objective
+
+	void swap( candidate & other );
+};
+
+/*
+	Class: search
+
+	Scalarized costs of a run.
+*/
+struct search
+{
+	const SCIP_HEURDATA * data;
+	std::vector<double> cost;     // Scalarized c(i,j)
+	std::vector<double> fixed;    // Scalarized f(j)
+	std::vector<int> order;       // Customers by decreasing demand
+	int evaluations;
+
+	explicit search( const SCIP_HEURDATA * data );
+};
+
+/*
+	Class: by_demand
+
+	Order of search::order.
+*/
+class by_demand
+{
+public:
+	explicit by_demand( const problem & instance ) : _instance( instance ) {}
+
+	bool operator () ( int a, int b ) const
+	{
+		return _instance.d[a] > _instance.d[b];
+	}
+
+private:
+	const problem & _instance;
+};
+
+/*
+	Function: evaluate
+
+	Assign the customers to the open facilities of a candidate, and score it.
+*/
+static void evaluate( search & context, candidate & solution );
+
+/*
+	Function: is_better
+
+	Return true if a candidate violates less, or as much but is cheaper.
+*/
+static bool is_better( const candidate & a, const candidate & b );
+
+/*
+	Function: improve
+
+	Apply the first improving move among dropping, adding and swapping
+	facilities.
+
+	Returns:
+		true if the candidate has been improved.
+*/
+static bool improve( search & context, candidate & current, candidate & trial );
+
+////////////////////////////////////////////////////////////////////////////////
+
+void candidate::swap( candidate & other )
+{
+	open.swap( other.open );
+	assignment.swap( other.assignment );
+	std::swap( violation, other.violation );
+	std::swap( value, other.value );
+}
+
+search::search( const SCIP_HEURDATA * data ) :
+	data( data ),
+	cost( (std::size_t)data->instance->num_customers * data->instance->num_facilities, 0. ),
+	fixed( data->instance->num_facilities, 0. ),
+	order( data->instance->num_customers ),
+	evaluations( 0 )
+{
+	const problem & instance = *data->instance;
+	const std::vector<double> & weights = *data->weights;
+
+	for ( int k = 0; k < instance.num_objectives; ++k )
+	{
+		const double * c = instance.c_objective( k );
+
+		if ( weights[k] == 0. )
+			continue;
+
+		for ( std::size_t ij = 0; ij < cost.size(); ++ij )
+		{
+			cost[ij] += weights[k] * c[ij];
+		}
+
+		for ( int j = 0; j < instance.num_facilities; ++j )
+		{
+			fixed[j] += weights[k] * instance.f[k][j];
+		}
+	}
+
+	for ( int i = 0; i < instance.num_customers; ++i )
+	{
+		order[i] = i;
+	}
+
+	if ( instance.capacitated )
+		std::stable_sort( order.begin(), order.end(), by_demand( instance ) );
+}
+
+void evaluate( search & context, candidate & solution )
+{
+	const problem & instance = *context.data->instance;
+	const std::vector<double> & lower = *context.data->lower;
+	const std::vector<double> & upper = *context.data->upper;
+	int m = instance.num_customers, n = instance.num_facilities;
+	std::vector<int> open;
+	std::vector<double> remaining;
+
+	++context.evaluations;
+
+	solution.assignment.clear();
+	solution.violation = 0.;
+
+	for ( int j = 0; j < n; ++j )
+	{
+		if ( solution.open[j] )
+			open.push_back( j );
+	}
+
+	if ( open.empty() )
+	{
+		solution.violation = std::numeric_limits<double>::infinity();
+		solution.value = std::numeric_limits<double>::infinity();
+		return;
+	}
+
+	if ( instance.capacitated )
+	{
+		remaining.resize( n );
+		for ( std::size_t s = 0; s < open.size(); ++s )
+			remaining[open[s]] = instance.q[open[s]];
+	}
+
+	for ( int index = 0; index < m; ++index )
+	{
+		int i = context.order[index];
+		const double * cost = &context.cost[(std::size_t)i * n];
+		double demand = ( instance.capacitated ? instance.d[i] : 0. );
+
+		// closed form: the cheapest open facility
+		if ( demand <= 0. )
+		{
+			int best = open[0];
+			for ( std::size_t s = 1; s < open.size(); ++s )
+			{
+				if ( cost[open[s]] < cost[best] )
+					best = open[s];
+			}
+			solution.assignment.push_back( std::make_pair( i*n + best, 1. ) );
+			continue;
+		}
+
+		// greedy repair: the cheapest open facilities with some capacity left
+		double left = demand;
+
+		while ( left > 1e-9 * demand )
+		{
+			int best = -1;
+			for ( std::size_t s = 0; s < open.size(); ++s )
+			{
+				int j = open[s];
+				double needed = ( instance.single_source ? left : 1e-9 * demand );
+
+				if ( remaining[j] >= needed && ( best < 0 || cost[j] < cost[best] ) )
+					best = j;
+			}
+
+			if ( best < 0 )
+			{
+				solution.violation += left;
+				break;
+			}
+
+			double amount = std::min( left, remaining[best] );
+			remaining[best] -= amount;
+			left -= amount;
+			solution.assignment.push_back( std::make_pair( i*n + best, instance.single_source ? 1. : amount / demand ) );
+		}
+	}
+
+	// objective values and epsilon constraints
+	solution.value = 0.;
+
+	for ( int k = 0; k < instance.num_objectives; ++k )
+	{
+		const double * c = instance.c_objective( k );
+		double z = 0.;
+
+		for ( std::size_t s = 0; s < open.size(); ++s )
+		{
+			z += instance.f[k][open[s]];
+		}
+
+		for ( std::size_t a = 0; a < solution.assignment.size(); ++a )
+		{
+			z += c[solution.assignment[a].first] * solution.assignment[a].second;
+		}
+
+		if ( z > upper[k] )
+			solution.violation += z - upper[k];
+		if ( z < lower[k] )
+			solution.violation += lower[k] - z;
+
+		solution.value += (*context.data->weights)[k] * z;
+	}
+}
+
+bool is_better( const candidate & a, const candidate & b )
+{
+	if ( a.violation != b.violation )
+		return a.violation < b.violation;
+
+	return a.value < b.value - 1e-9 * std::max( 1., std::fabs( b.value ) );
+}
+
+bool improve( search & context, candidate & current, candidate & trial )
+{
+	int n = context.data->instance->num_facilities;
+	int num_open = (int)std::count( current.open.begin(), current.open.end(), (char)1 );
+
+	// drop a facility
+	for ( int j = 0; j < n && num_open > 1; ++j )
+	{
+		if ( !current.open[j] || context.evaluations >= context.data->max_evaluations )
+			continue;
+
+		trial.open = current.open;
+		trial.open[j] = 0;
+		evaluate( context, trial );
+
+		if ( is_better( trial, current ) )
+		{
+			current.swap( trial );
+			return true;
+		}
+	}
+
+	// add a facility
+	for ( int j = 0; j < n; ++j )
+	{
+		if ( current.open[j] || context.evaluations >= context.data->max_evaluations )
+			continue;
+
+		trial.open = current.open;
+		trial.open[j] = 1;
+		evaluate( context, trial );
+
+		if ( is_better( trial, current ) )
+		{
+			current.swap( trial );
+			return true;
+		}
+	}
+
+	// swap an open facility with a closed one
+	for ( int j = 0; j < n; ++j )
+	{
+		if ( !current.open[j] )
+			continue;
+
+		for ( int l = 0; l < n; ++l )
+		{
+			if ( current.open[l] )
+				continue;
+
+			if ( context.evaluations >= context.data->max_evaluations )
+				return false;
+
+			trial.open = current.open;
+			trial.open[j] = 0;
+			trial.open[l] = 1;
+			evaluate( context, trial );
+
+			if ( is_better( trial, current ) )
+			{
+				current.swap( trial );
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+static SCIP_DECL_HEUREXEC(heurExecFlp)
+{
+	SCIP_HEURDATA * data = SCIPheurGetData( heur );
+	const problem & instance = *data->instance;
+	int n = instance.num_facilities;
+	SCIP_SOL * incumbent = SCIPgetBestSol( scip );
+
+	search context( data );
+	candidate current, trial;
+
+	*result = SCIP_DIDNOTFIND;
+
+	current.open.assign( n, 0 );
+
+	if ( incumbent )
+	{
+		// start from the facilities of the incumbent, the warm start if any
+		for ( int j = 0; j < n; ++j )
+		{
+			current.open[j] = ( SCIPgetSolVal( scip, incumbent, data->vars[j] ) > 0.5 );
+		}
+		evaluate( context, current );
+	}
+	else
+	{
+		// open the facility that improves the most until none does
+		evaluate( context, current );
+
+		for ( bool added = true; added && context.evaluations < data->max_evaluations; )
+		{
+			candidate best;
+			best.violation = current.violation;
+			best.value = current.value;
+			added = false;
+
+			for ( int j = 0; j < n && context.evaluations < data->max_evaluations; ++j )
+			{
+				if ( current.open[j] )
+					continue;
+
+				trial.open = current.open;
+				trial.open[j] = 1;
+				evaluate( context, trial );
+
+				if ( is_better( trial, best ) )
+				{
+					best.swap( trial );
+					added = true;
+				}
+			}
+
+			if ( added )
+				current.swap( best );
+		}
+	}
+
+	while ( context.evaluations < data->max_evaluations && improve( context, current, trial ) )
+		;
+
+	// the epsilon constraints or capacities cannot be met
+	if ( current.violation > 0. )
+		return SCIP_OKAY;
+
+	SCIP_SOL * sol;
+	SCIP_Bool stored;
+
+	SCIP_CALL( SCIPcreateOrigSol( scip, &sol, heur ) );
+
+	for ( int j = 0; j < n; ++j )
+	{
+		if ( current.open[j] )
+			SCIP_CALL( SCIPsetSolVal( scip, sol, data->vars[j], 1. ) );
+	}
+
+	for ( std::size_t a = 0; a < current.assignment.size(); ++a )
+	{
+		SCIP_CALL( SCIPsetSolVal( scip, sol, data->vars[n + current.assignment[a].first],
+			current.assignment[a].second ) );
+	}
+
+	SCIP_CALL( SCIPtrySolFree( scip, &sol, FALSE, TRUE, TRUE, TRUE, &stored ) );
+
+	if ( stored )
+		*result = SCIP_FOUNDSOL;
+
+	return SCIP_OKAY;
+}
+
+static SCIP_DECL_HEURFREE(heurFreeFlp)
+{
+	delete SCIPheurGetData( heur );
+	SCIPheurSetData( heur, 0 );
+	return SCIP_OKAY;
+}
+
+SCIP_RETCODE include_flp_heur( SCIP * scip, const problem & instance, SCIP_VAR ** vars,
+	const std::vector<double> * weights, const std::vector<double> * lower, const std::vector<double> * upper )
+{
+	SCIP_HEURDATA * data = new SCIP_HEURDATA;
+	SCIP_HEUR * heur;
+
+	data->instance = &instance;
+	data->vars.assign( vars, vars + instance.num_facilities + instance.num_customers * instance.num_facilities );
+	data->weights = weights;
+	data->lower = lower;
+	data->upper = upper;
+	data->max_evaluations = DEFAULT_MAXEVALUATIONS;
+
+	SCIP_CALL( SCIPincludeHeurBasic( scip, &heur, HEUR_NAME, HEUR_DESC, HEUR_DISPCHAR, HEUR_PRIORITY,
+		HEUR_FREQ, HEUR_FREQOFS, HEUR_MAXDEPTH, HEUR_TIMING, HEUR_USESSUBSCIP, heurExecFlp, data ) );
+	SCIP_CALL( SCIPsetHeurFree( scip, heur, heurFreeFlp ) );
+
+	SCIP_CALL( SCIPaddIntParam( scip, "heuristics/" HEUR_NAME "/maxevaluations",
+		"maximal number of sets of open facilities evaluated by a run",
+		&data->max_evaluations, FALSE, DEFAULT_MAXEVALUATIONS, 1, std::numeric_limits<int>::max(), 0, 0 ) );
+
+	return SCIP_OKAY;
+}
@@ -14,12 +14,19 @@
 */
 
 #include "flp_solver.hpp"
+#include "opening_conshdlr.hpp"
+#include "flp_heur.hpp"
+#include "timer.hpp"
+#include "interrupt_eventhdlr.hpp"
 #include <scip/scipdefplugins.h>
 #include <scip/retcode.h>
 #include <sstream>
+#include <stdexcept>
 #include <numeric>
 #include <algorithm>
+#include <limits>
 #include <cstdio>
+#include <cmath>
 
 // Exception calling macro
 #define SCIP_CALL_EXC(x)                        \
@@ -27,11 +34,47 @@
 	SCIP_RETCODE retcode;                   \
 	if( (retcode = (x)) != SCIP_OKAY)       \
 	{                                       \
-		SCIPretcodePrintError(retcode); \
-		throw;                          \
+		throw scip_error( retcode );    \
 	}                                       \
 }
 
+/*
+	Function: scip_error
+
+	Returns:
+		An exception describing a SCIP return code.
+*/
+static std::runtime_error scip_error( SCIP_RETCODE retcode )
+{
+	const char * name;
+	std::ostringstream os;
+
+	switch ( retcode )
+	{
+		case SCIP_ERROR:              name = "unspecified error"; break;
+		case SCIP_NOMEMORY:           name = "insufficient memory"; break;
+		case SCIP_READERROR:          name = "read error"; break;
+		case SCIP_WRITEERROR:         name = "write error"; break;
+		case SCIP_NOFILE:             name = "file not found"; break;
+		case SCIP_FILECREATEERROR:    name = "cannot create file"; break;
+		case SCIP_LPERROR:            name = "error in LP solver"; break;
+		case SCIP_NOPROBLEM:          name = "no problem exists"; break;
+		case SCIP_INVALIDCALL:        name = "method cannot be called at this time"; break;
+		case SCIP_INVALIDDATA:        name = "method cannot be called with this type of data"; break;
+		case SCIP_INVALIDRESULT:      name = "method returned an invalid result code"; break;
+		case SCIP_PLUGINNOTFOUND:     name = "a required plugin was not found"; break;
+		case SCIP_PARAMETERUNKNOWN:   name = "the parameter with the given name was not found"; break;
+		case SCIP_PARAMETERWRONGTYPE: name = "the parameter is not of the expected type"; break;
+		case SCIP_PARAMETERWRONGVAL:  name = "the value is invalid for the given parameter"; break;
+		case SCIP_KEYALREADYEXISTING: name = "the given key is already existing in table"; break;
+		case SCIP_MAXDEPTHLEVEL:      name = "maximal branching depth level exceeded"; break;
+		default:                      name = "unknown error"; break;
+	}
+
+	os << "SCIP error <" << retcode << ">: " << name;
+	return std::runtime_error( os.str() );
+}
+
 // Definition of the SCIP message handler
 
 static SCIP_DECL_MESSAGEWARNING(messageWarningClog)
@@ -74,26 +117,87 @@ static SCIP_DECL_MESSAGEINFO(messageInfoClog)
 	}
 }
 
-flp_solver::flp_solver( const problem & instance, bool relaxation ) :
+/*
+	Function: status_name
+
+	Returns:
+		The name of a SCIP status, as used by SCIP statistics.
+*/
+static const char * status_name( SCIP_STATUS status )
+{
+	switch ( status )
+	{
+		case SCIP_STATUS_USERINTERRUPT:  return "user interrupt";
+		case SCIP_STATUS_NODELIMIT:      return "node limit";
+		case SCIP_STATUS_TOTALNODELIMIT: return "total node limit";
+		case SCIP_STATUS_STALLNODELIMIT: return "stall node limit";
+		case SCIP_STATUS_TIMELIMIT:      return "time limit";
+		case SCIP_STATUS_MEMLIMIT:       return "memory limit";
+		case SCIP_STATUS_GAPLIMIT:       return "gap limit";
+		case SCIP_STATUS_SOLLIMIT:       return "solution limit";
+		case SCIP_STATUS_BESTSOLLIMIT:   return "best solution limit";
+		case SCIP_STATUS_RESTARTLIMIT:   return "restart limit";
+		case SCIP_STATUS_OPTIMAL:        return "optimal";
+		case SCIP_STATUS_INFEASIBLE:     return "infeasible";
+		case SCIP_STATUS_UNBOUNDED:      return "unbounded";
+		case SCIP_STATUS_INFORUNBD:      return "infeasible or unbounded";
+		default:                         return "unknown";
+	}
+}
+
+flp_solver::flp_solver( const problem & instance, bool relaxation, bool lazy_opening ) :
 	instance( instance ),
 	_scip( 0 ),
-	_sol( 0 ),
+	_values(),
+	_objective( 0. ),
+	_objectives(),
 	_x( instance.num_customers, std::vector<SCIP_VAR *>( instance.num_facilities ) ),
 	_y( instance.num_facilities ),
+	_vars(),
 	_assign_cons( instance.num_customers, (SCIP_CONS *)0 ),
 	_assign_dual( instance.num_customers ),
 	_cap_cons( instance.num_facilities, (SCIP_CONS *)0 ),
 	_cap_dual( instance.num_facilities ),
-	_open_cons( instance.num_customers, std::vector<SCIP_CONS *>( instance.num_facilities, (SCIP_CONS *)0 ) ),
-	_open_dual( instance.num_customers, std::vector<double>( instance.num_facilities ) ),
-	_epsilon_cons( 0 ),
+	_open_cons(),
+	_open_dual(),
+	_epsilon_cons( instance.num_objectives, (SCIP_CONS *)0 ),
+	_epsilon_lhs( instance.num_objectives, -std::numeric_limits<double>::infinity() ),
+	_epsilon_rhs( instance.num_objectives, std::numeric_limits<double>::infinity() ),
+	_epsilon_cuts( instance.num_objectives, (SCIP_CONS *)0 ),
+	_bound_cons( 0 ),
+	_dual_bound( -std::numeric_limits<double>::infinity() ),
+	_start(),
 	_mainobj( 0 ),
-	_relaxation( relaxation )
+	_augmentation( 0. ),
+	_weights( instance.num_objectives, 0. ),
+	_relaxation( relaxation ),
+	_lazy_opening( lazy_opening ),
+	_warm_start( false ),
+	_reoptimization( false ),
+	_dual_extraction( false ),
+	_heuristic( false ),
+	_named( false ),
+	_build_time( 0. ),
+	_interrupted( false ),
+	_statistics(),
+	_trace( 0 ),
+	_record(),
+	_budget( 0 ),
+	_bounds( 0 ),
+	_observer( 0 ),
+	_solutions( 0 ),
+	_candidates( 0 )
 {
+	timer clock;
+
 	initialize_problem();
 	initialize_variables();
 	initialize_assignment_constraints();
-	initialize_opening_constraints();
+
+	if ( _lazy_opening )
+		initialize_lazy_opening_constraints();
+	else
+		initialize_opening_constraints();
 
 	if ( instance.capacitated )
 	{
@@ -102,90 +206,525 @@ flp_solver::flp_solver( const problem & instance, bool relaxation ) :
 	}
 
 	initialize_epsilon_constraints();
+
+	// the heuristic reads the scalarization of each solve
+	if ( !_relaxation )
+	{
+		SCIP_CALL_EXC( include_flp_heur( _scip, instance, &_vars[0], &_weights, &_epsilon_lhs, &_epsilon_rhs ) );
+		set_heuristic( false );
+	}
+
+	_build_time = clock.elapsed();
 }
 
 flp_solver::~flp_solver()
 {
 	// after releasing all vars and cons we can free the scip problem
 	// remember this has allways to be the last call to scip
-	SCIP_CALL_EXC( SCIPfree( &_scip ) );
+	// (no exception may leave a destructor)
+	try
+	{
+		release_epsilon_cuts();
+	}
+	catch ( const std::exception & )
+	{
+	}
+
+	SCIP_RETCODE retcode = SCIPfree( &_scip );
+	if ( retcode != SCIP_OKAY )
+		SCIPretcodePrintError( retcode );
 }
 
 bool flp_solver::weighted_sum( double lambda )
 {
-	int k = _mainobj, l = ( _mainobj == 1 ? 0 : 1 );
+	_record.scalarization = "weighted_sum";
+	_record.lambda = lambda;
 
-	// modify objective of y(j)
-	for ( int j = 0; j < instance.num_facilities; ++j )
+	int k = _mainobj, l = ( _mainobj == 1 ? 0 : 1 ), n = instance.num_facilities;
+	int mn = instance.num_customers * n;
+	const double * ck = instance.c_objective( k ), * cl = instance.c_objective( l );
+	std::vector<double> obj( _vars.size() );
+
+	// objective of y(j)
+	for ( int j = 0; j < n; ++j )
 	{
-		SCIP_CALL_EXC( SCIPchgVarObj( _scip, _y[j],
-			( 1. - lambda ) * instance.f[k][j] + lambda * instance.f[l][j] ) );
+		obj[j] = ( 1. - lambda ) * instance.f[k][j] + lambda * instance.f[l][j];
 	}
 
-	// modify objective of x(i,j)
-	for ( int i = 0; i < instance.num_customers; ++i )
+	// objective of x(i,j), costs and variables share the same layout
+	for ( int ij = 0; ij < mn; ++ij )
 	{
-		for ( int j = 0; j < instance.num_facilities; ++j )
+		obj[n + ij] = ( 1. - lambda ) * ck[ij] + lambda * cl[ij];
+	}
+
+	change_objective( obj );
+
+	_weights.assign( instance.num_objectives, 0. );
+	_weights[k] = 1. - lambda;
+	_weights[l] = lambda;
+
+	// the bound on the main objective does not apply to weighted sums
+	if ( SCIPgetStage( _scip ) == SCIP_STAGE_PROBLEM )
+	{
+		SCIP_CALL_EXC( SCIPchgLhsLinear( _scip, _bound_cons, -SCIPinfinity( _scip ) ) );
+	}
+
+	bool found = optimize();
+
+	// the dual bound of a weighted sum is useless for epsilon-constraints
+	_dual_bound = -std::numeric_limits<double>::infinity();
+
+	return found;
+}
+
+bool flp_solver::epsilon_constraint( double epsilon, double lower )
+{
+	int l = ( _mainobj == 0 ? 1 : 0 );
+	std::vector<double> upper_bounds( instance.num_objectives, std::numeric_limits<double>::infinity() );
+	std::vector<double> lower_bounds( instance.num_objectives, -std::numeric_limits<double>::infinity() );
+
+	upper_bounds[l] = epsilon;
+	lower_bounds[l] = lower;
+
+	return epsilon_constraint( upper_bounds, lower_bounds );
+}
+
+bool flp_solver::epsilon_constraint( const std::vector<double> & epsilon )
+{
+	return epsilon_constraint( epsilon,
+		std::vector<double>( instance.num_objectives, -std::numeric_limits<double>::infinity() ) );
+}
+
+bool flp_solver::epsilon_constraint( const std::vector<double> & epsilon, const std::vector<double> & lower )
+{
+	int p = instance.num_objectives, l = ( _mainobj == 0 ? 1 : 0 );
+	bool shrunk = true;
+
+	_record.scalarization = "epsilon_constraint";
+	_record.epsilon = epsilon[l];
+	_record.lower = lower[l];
+	_record.epsilons.clear();
+
+	if ( p > 2 )
+	{
+		_record.epsilons = epsilon;
+		_record.epsilons[_mainobj] = std::numeric_limits<double>::infinity();
+	}
+
+	// the previous dual bound remains valid if the feasible set has shrunk
+	for ( int k = 0; k < p; ++k )
+	{
+		if ( k != _mainobj && ( epsilon[k] > _epsilon_rhs[k] || lower[k] < _epsilon_lhs[k] ) )
+			shrunk = false;
+	}
+
+	// reoptimization only supports shrinking feasible sets
+	if ( _reoptimization && !shrunk )
+		restart();
+
+	for ( int k = 0; k < p; ++k )
+	{
+		if ( k == _mainobj )
+			continue;
+
+		_epsilon_rhs[k] = epsilon[k];
+		_epsilon_lhs[k] = lower[k];
+	}
+
+	// tighten the transformed problem kept for reoptimization
+	if ( SCIPgetStage( _scip ) != SCIP_STAGE_PROBLEM )
+	{
+		add_epsilon_cut();
+		return optimize();
+	}
+
+	// modify both sides of epsilon constraints
+	for ( int k = 0; k < p; ++k )
+	{
+		if ( k == _mainobj )
+			continue;
+
+		SCIP_CALL_EXC( SCIPchgRhsLinear( _scip, _epsilon_cons[k], std::min( epsilon[k], SCIPinfinity( _scip ) ) ) );
+		SCIP_CALL_EXC( SCIPchgLhsLinear( _scip, _epsilon_cons[k], std::max( lower[k], -SCIPinfinity( _scip ) ) ) );
+	}
+
+	// z(mainobj) >= previous dual bound, with some tolerance
+	double bound = -SCIPinfinity( _scip );
+	if ( _warm_start && !_reoptimization && shrunk && _dual_bound > bound )
+		bound = _dual_bound - 1e-6 * std::max( 1., std::fabs( _dual_bound ) );
+	SCIP_CALL_EXC( SCIPchgLhsLinear( _scip, _bound_cons, bound ) );
+
+	return optimize();
+}
+
+bool flp_solver::optimize()
+{
+	SCIP_SOL * sol;
+
+	// split what is left of the budget
+	if ( _budget )
+	{
+		if ( _budget->exhausted() )
 		{
-			SCIP_CALL_EXC( SCIPchgVarObj( _scip, _x[i][j],
-				( 1. - lambda ) * instance.c[k][i][j] + lambda * instance.c[l][i][j] ) );
+			_interrupted = true;
+			_values.clear();
+			_dual_bound = -std::numeric_limits<double>::infinity();
+			_start.clear();
+			return false;
 		}
+
+		long nodes = _budget->nodes_left();
+		SCIP_CALL_EXC( SCIPsetRealParam( _scip, "limits/time", std::min( _budget->time_left(), SCIPinfinity( _scip ) ) ) );
+		SCIP_CALL_EXC( SCIPsetLongintParam( _scip, "limits/nodes", nodes < 0 ? -1 : nodes ) );
 	}
 
+	if ( _warm_start && !_reoptimization )
+		add_start();
+
+	if ( _candidates && !_reoptimization )
+		set_cutoff();
+
 	// this tells scip to start the solution process
+	timer clock;
 	SCIP_CALL_EXC( SCIPpresolve( _scip ) );
+	_record.presolve_time = clock.elapsed();
+
+	clock.restart();
 	SCIP_CALL_EXC( SCIPsolve( _scip ) );
+	_record.solve_time = clock.elapsed();
+
+	_record.nodes = SCIPgetNNodes( _scip );
+	_record.lp_iterations = SCIPgetNLPIterations( _scip );
+	_record.gap = SCIPgetGap( _scip );
+
+	// an incumbent of a stopped solve is not proven optimal
+	SCIP_STATUS status = SCIPgetStatus( _scip );
+	_record.status = status_name( status );
+	bool optimal = ( status == SCIP_STATUS_OPTIMAL );
+	_interrupted = !optimal && status != SCIP_STATUS_INFEASIBLE
+		&& status != SCIP_STATUS_UNBOUNDED && status != SCIP_STATUS_INFORUNBD;
+
+	++_statistics.solves;
+	_statistics.nodes += _record.nodes;
+	_statistics.lp_iterations += _record.lp_iterations;
+
+	if ( _budget )
+		_budget->consume_nodes( _record.nodes );
+
+	// store the solution and dual values before the problem is free
+	_dual_bound = SCIPgetDualbound( _scip );
+
+	// the dual bound is valid even if the solve has been stopped
+	_record.dual_bound = _dual_bound;
+	if ( SCIPisInfinity( _scip, _dual_bound ) )
+		_record.dual_bound = std::numeric_limits<double>::infinity();
+	else if ( SCIPisInfinity( _scip, -_dual_bound ) )
+		_record.dual_bound = -std::numeric_limits<double>::infinity();
+
+	// the lower bound set is bi-objective
+	if ( _bounds && instance.num_objectives == 2 )
+	{
+		if ( _record.scalarization == std::string( "weighted_sum" ) )
+			_bounds->add_weighted_sum( _mainobj, _record.lambda, _record.dual_bound );
+		else if ( _augmentation == 0. )
+			_bounds->add_epsilon_constraint( _mainobj, _record.lower, _record.epsilon, _record.dual_bound );
+		else if ( _record.epsilon < std::numeric_limits<double>::infinity() )
+			_bounds->add_epsilon_constraint( _mainobj, _record.lower, _record.epsilon,
+				_record.dual_bound - _augmentation * _record.epsilon );
+	}
+
+	sol = SCIPgetBestSol( _scip );
+	_values.resize( sol ? _vars.size() : 0 );
+
+	// fetch the whole solution at once
+	if ( sol )
+	{
+		SCIP_CALL_EXC( SCIPgetSolVals( _scip, sol, (int)_vars.size(), &_vars[0], &_values[0] ) );
+		_objective = SCIPgetSolOrigObj( _scip, sol );
+		evaluate();
+	}
+
+	// an optimal solution of min z(k) alone bounds z(l) on the whole front
+	if ( _bounds && instance.num_objectives == 2 && sol && optimal )
+	{
+		int k = -1, l = ( _mainobj == 0 ? 1 : 0 );
+
+		if ( _record.scalarization == std::string( "weighted_sum" ) )
+			k = ( _record.lambda == 0. ? _mainobj : _record.lambda == 1. ? l : -1 );
+		else if ( _augmentation == 0. && _record.epsilon == std::numeric_limits<double>::infinity()
+			&& _record.lower == -std::numeric_limits<double>::infinity() )
+			k = _mainobj;
+
+		if ( k >= 0 )
+			_bounds->add_nadir_bound( 1 - k, _objectives[1 - k] );
+	}
 
-	// store dual values before the problem is free
-	store_dual();
-	SCIP_CALL_EXC( SCIPfreeTransform( _scip ) );
+	if ( _candidates )
+		harvest();
 
-	_sol = SCIPgetBestSol( _scip );
+	clock.restart();
+	if ( _dual_extraction )
+		store_dual();
+	_record.dual_time = clock.elapsed();
 
-	return _sol != 0;
+	// keep the search tree and the transformed problem for reoptimization
+	clock.restart();
+	if ( _reoptimization )
+	{
+		SCIP_CALL_EXC( SCIPfreeReoptSolve( _scip ) );
+	}
+	else
+	{
+		release_epsilon_cuts();
+		SCIP_CALL_EXC( SCIPfreeTransform( _scip ) );
+	}
+	_record.free_time = clock.elapsed();
+
+	if ( _trace )
+	{
+		if ( _values.empty() )
+			_record.objectives.clear();
+		else
+			_record.objectives = _objectives;
+		_trace->write( _record );
+	}
+
+	// the solution found is the start of the next solve
+	_start = _values;
+
+	// a stopped solve leaves its task pending, its incumbent being only kept
+	// as a start and in the candidate pool
+	if ( _values.empty() || !optimal )
+	{
+		_dual_bound = -std::numeric_limits<double>::infinity();
+		return false;
+	}
+
+	return true;
+}
+
+void flp_solver::restart()
+{
+	if ( SCIPgetStage( _scip ) != SCIP_STAGE_PROBLEM )
+	{
+		release_epsilon_cuts();
+		SCIP_CALL_EXC( SCIPfreeTransform( _scip ) );
+	}
 }
 
-bool flp_solver::epsilon_constraint( double epsilon )
+void flp_solver::change_objective( std::vector<double> & obj )
 {
-	// modify right hand side of epsilon constraint
-	SCIP_CALL_EXC( SCIPchgRhsLinear( _scip, _epsilon_cons, epsilon ) );
+	if ( _reoptimization )
+	{
+		SCIP_CALL_EXC( SCIPchgReoptObjective( _scip, SCIP_OBJSENSE_MINIMIZE, &_vars[0], &obj[0], (int)_vars.size() ) );
+		return;
+	}
 
-	// this tells scip to start the solution process
-	SCIP_CALL_EXC( SCIPpresolve( _scip ) );
-	SCIP_CALL_EXC( SCIPsolve( _scip ) );
+	for ( std::size_t v = 0; v < _vars.size(); ++v )
+	{
+		SCIP_CALL_EXC( SCIPchgVarObj( _scip, _vars[v], obj[v] ) );
+	}
+}
 
-	// store dual values before the problem is free
-	store_dual();
-	SCIP_CALL_EXC( SCIPfreeTransform( _scip ) );
+void flp_solver::add_epsilon_cut()
+{
+	std::vector<SCIP_VAR *> vars;
+	std::vector<double> vals;
+
+	for ( int l = 0; l < instance.num_objectives; ++l )
+	{
+		// skip the main objective and the unbounded ones
+		if ( l == _mainobj || ( _epsilon_lhs[l] == -std::numeric_limits<double>::infinity()
+			&& _epsilon_rhs[l] == std::numeric_limits<double>::infinity() ) )
+			continue;
+
+		double lhs = std::max( _epsilon_lhs[l], -SCIPinfinity( _scip ) );
+		double rhs = std::min( _epsilon_rhs[l], SCIPinfinity( _scip ) );
+
+		// the feasible set only shrinks, one row per objective is enough
+		if ( _epsilon_cuts[l] && !SCIPconsIsDeleted( _epsilon_cuts[l] ) )
+		{
+			SCIP_CALL_EXC( SCIPchgRhsLinear( _scip, _epsilon_cuts[l], rhs ) );
+			SCIP_CALL_EXC( SCIPchgLhsLinear( _scip, _epsilon_cuts[l], lhs ) );
+			continue;
+		}
+
+		// the presolver may have deleted or upgraded the previous cut
+		if ( _epsilon_cuts[l] )
+		{
+			SCIP_CALL_EXC( SCIPreleaseCons( _scip, &_epsilon_cuts[l] ) );
+		}
+
+		if ( vars.empty() )
+		{
+			vars.resize( _vars.size() );
+			SCIP_CALL_EXC( SCIPgetTransformedVars( _scip, (int)_vars.size(), &_vars[0], &vars[0] ) );
+		}
+
+		objective_coefficients( l, vals );
+
+		// lower <= objective <= epsilon, added to the transformed problem
+		SCIP_CALL_EXC( SCIPcreateConsLinear( _scip, &_epsilon_cuts[l], "epsilon_cut", (int)vars.size(), &vars[0], &vals[0],
+			lhs, rhs, true, true, true, true, true, false, false, false, false, false ) );
 
-	_sol = SCIPgetBestSol( _scip );
+		SCIP_CALL_EXC( SCIPaddCons( _scip, _epsilon_cuts[l] ) );
+	}
+}
 
-	return _sol != 0;
+void flp_solver::release_epsilon_cuts()
+{
+	for ( int l = 0; l < instance.num_objectives; ++l )
+	{
+		if ( _epsilon_cuts[l] )
+		{
+			SCIP_CALL_EXC( SCIPreleaseCons( _scip, &_epsilon_cuts[l] ) );
+		}
+	}
 }
 
-double flp_solver::z( int k ) const
+void flp_solver::add_start()
 {
-	double obj( 0 );
+	if ( _start.size() != _vars.size() )
+		return;
 
-	for ( int j = 0; j < instance.num_facilities; ++j )
+	int n = instance.num_facilities, mn = instance.num_customers * n;
+
+	for ( int l = 0; l < instance.num_objectives; ++l )
 	{
-		if ( _relaxation )
-			obj += y_real( j ) * instance.f[k][j];
-		else if ( y( j ) )
-			obj += instance.f[k][j];
+		if ( l == _mainobj )
+			continue;
+
+		// z(l) of the start
+		const double * cl = instance.c_objective( l );
+		double obj( 0 );
+
+		for ( int j = 0; j < n; ++j )
+		{
+			obj += _start[j] * instance.f[l][j];
+		}
+
+		for ( int ij = 0; ij < mn; ++ij )
+		{
+			obj += _start[n + ij] * cl[ij];
+		}
+
+		// skip the start if it violates an epsilon constraint
+		double tol = 1e-6 * std::max( 1., std::fabs( obj ) );
+		if ( obj > _epsilon_rhs[l] + tol || obj < _epsilon_lhs[l] - tol )
+			return;
 	}
 
-	for ( int i = 0; i < instance.num_customers; ++i )
+	SCIP_SOL * sol;
+	SCIP_Bool stored;
+
+	SCIP_CALL_EXC( SCIPcreateOrigSol( _scip, &sol, 0 ) );
+	SCIP_CALL_EXC( SCIPsetSolVals( _scip, sol, (int)_vars.size(), &_vars[0], &_start[0] ) );
+	SCIP_CALL_EXC( SCIPaddSolFree( _scip, &sol, &stored ) );
+}
+
+void flp_solver::solution( std::vector<double> & values ) const
+{
+	values = _values;
+}
+
+void flp_solver::set_start( const std::vector<double> & values )
+{
+	_start = values;
+}
+
+void flp_solver::set_heuristic( bool enable )
+{
+	if ( _relaxation )
+		return;
+
+	_heuristic = enable;
+	SCIP_CALL_EXC( SCIPsetIntParam( _scip, "heuristics/flp/freq", enable ? 0 : -1 ) );
+}
+
+void flp_solver::set_reoptimization( bool enable )
+{
+	restart();
+	_reoptimization = enable;
+	SCIP_CALL_EXC( SCIPenableReoptimization( _scip, enable ) );
+}
+
+void flp_solver::evaluate()
+{
+	evaluate( _values, _objectives );
+}
+
+void flp_solver::evaluate( const std::vector<double> & values, std::vector<double> & objectives ) const
+{
+	int n = instance.num_facilities, mn = instance.num_customers * n;
+	std::vector<double> w( values );
+
+	// integer variables count for 0 or 1
+	if ( !_relaxation )
 	{
-		for ( int j = 0; j < instance.num_facilities; ++j )
+		for ( int j = 0; j < n; ++j )
+		{
+			w[j] = ( w[j] > 0.5 ) ? 1. : 0.;
+		}
+
+		if ( instance.single_source )
+		{
+			for ( int ij = 0; ij < mn; ++ij )
+			{
+				w[n + ij] = ( w[n + ij] > 0.5 ) ? 1. : 0.;
+			}
+		}
+	}
+
+	// one dot product per objective, costs and variables share the same layout
+	objectives.assign( instance.num_objectives, 0. );
+
+	for ( int k = 0; k < instance.num_objectives; ++k )
+	{
+		const double * f = &instance.f[k][0], * c = instance.c_objective( k ), * x = &w[n];
+		double obj( 0 );
+
+		for ( int j = 0; j < n; ++j )
+		{
+			obj += f[j] * w[j];
+		}
+
+		for ( int ij = 0; ij < mn; ++ij )
 		{
-			if ( _relaxation || !instance.single_source )
-				obj += x_real( i, j ) * instance.c[k][i][j];
-			else if ( x( i, j ) )
-				obj += instance.c[k][i][j];
+			obj += c[ij] * x[ij];
 		}
+
+		objectives[k] = obj;
+	}
+}
+
+void flp_solver::set_cutoff()
+{
+	double value, limit = SCIPinfinity( _scip );
+
+	// the main objective is only bounded by the bound constraint
+	std::vector<double> lower( _epsilon_lhs ), upper( _epsilon_rhs );
+	lower[_mainobj] = -std::numeric_limits<double>::infinity();
+	upper[_mainobj] = std::numeric_limits<double>::infinity();
+
+	// with some tolerance, so that the optimum is not cut off when it is the candidate
+	if ( _candidates->best( _weights, lower, upper, value ) )
+		limit = value + 1e-6 * std::max( 1., std::fabs( value ) );
+
+	SCIP_CALL_EXC( SCIPsetObjlimit( _scip, limit ) );
+}
+
+void flp_solver::harvest()
+{
+	int count = SCIPgetNSols( _scip );
+	SCIP_SOL ** sols = SCIPgetSols( _scip );
+	std::vector<double> values( _vars.size() ), z;
+
+	for ( int s = 0; s < count; ++s )
+	{
+		SCIP_CALL_EXC( SCIPgetSolVals( _scip, sols[s], (int)_vars.size(), &_vars[0], &values[0] ) );
+		evaluate( values, z );
+		_candidates->insert( z );
 	}
-	return obj;
 }
 
 int flp_solver::get_verblevel() const
@@ -203,6 +742,7 @@ void flp_solver::set_verblevel( int level ) const
 void flp_solver::write_lp( FILE * fp, const std::string & ext ) const
 {
 	int level = get_verblevel();
+	name_model();
 	set_verblevel( SCIP_VERBLEVEL_FULL );
 	SCIP_CALL_EXC( SCIPprintOrigProblem( _scip, fp, ext.empty() ? 0 : ext.c_str(), false ) );
 	set_verblevel( level );
@@ -211,32 +751,75 @@ void flp_solver::write_lp( FILE * fp, const std::string & ext ) const
 void flp_solver::write_lp( const std::string & filename, const std::string & ext ) const
 {
 	int level = get_verblevel();
+	name_model();
 	set_verblevel( SCIP_VERBLEVEL_FULL );
 	SCIP_CALL_EXC( SCIPwriteOrigProblem( _scip, filename.c_str(), ext.empty() ? 0 : ext.c_str(), false ) );
 	set_verblevel( level );
 }
 
+void flp_solver::set_budget( budget * limits )
+{
+	_budget = limits;
+
+	// budget::catch_signals replaces the SCIP ctrl-c handler, which is not
+	// safe with several threads, by the interrupt event handler
+	SCIP_CALL_EXC( SCIPsetBoolParam( _scip, "misc/catchctrlc", limits == 0 ) );
+}
+
+void flp_solver::copy_settings( const flp_solver & other )
+{
+	set_verblevel( other.get_verblevel() );
+	set_warm_start( other.get_warm_start() );
+	set_reoptimization( other.get_reoptimization() );
+	set_dual_extraction( other.get_dual_extraction() );
+	set_heuristic( other.get_heuristic() );
+	set_trace( other.get_trace() );
+	set_budget( other.get_budget() );
+	set_lower_bound_set( other.get_lower_bound_set() );
+	set_observer( other.get_observer() );
+	set_solution_store( other.get_solution_store() );
+	set_candidate_pool( other.get_candidate_pool() );
+	set_augmentation( other.get_augmentation() );
+}
+
 void flp_solver::set_main_objective( int k )
 {
-	_mainobj = k;
+	std::vector<double> obj;
 
-	SCIP_CALL_EXC( SCIPdelCons( _scip, _epsilon_cons ) );
-	initialize_epsilon_constraints();
+	_mainobj = k;
 
-	// modify objective of y(j)
-	for ( int j = 0; j < instance.num_facilities; ++j )
-	{
-		SCIP_CALL_EXC( SCIPchgVarObj( _scip, _y[j], instance.f[k][j] ) );
-	}
+	// constraints of the original problem can only be changed in problem stage
+	restart();
 
-	// modify objective of x(i,j)
-	for ( int i = 0; i < instance.num_customers; ++i )
+	for ( int l = 0; l < instance.num_objectives; ++l )
 	{
-		for ( int j = 0; j < instance.num_facilities; ++j )
+		if ( _epsilon_cons[l] )
 		{
-			SCIP_CALL_EXC( SCIPchgVarObj( _scip, _x[i][j], instance.c[k][i][j] ) );
+			SCIP_CALL_EXC( SCIPdelCons( _scip, _epsilon_cons[l] ) );
 		}
 	}
+
+	SCIP_CALL_EXC( SCIPdelCons( _scip, _bound_cons ) );
+	initialize_epsilon_constraints();
+
+	_epsilon_lhs.assign( instance.num_objectives, -std::numeric_limits<double>::infinity() );
+	_epsilon_rhs.assign( instance.num_objectives, std::numeric_limits<double>::infinity() );
+	_dual_bound = -std::numeric_limits<double>::infinity();
+
+	epsilon_coefficients( obj );
+
+	change_objective( obj );
+
+	_weights.assign( instance.num_objectives, _augmentation );
+	_weights[_mainobj] = 1.;
+}
+
+void flp_solver::set_augmentation( double weight )
+{
+	_augmentation = weight;
+
+	// the bound constraint depends on the augmentation
+	set_main_objective( _mainobj );
 }
 
 void flp_solver::initialize_problem()
@@ -248,6 +831,7 @@ void flp_solver::initialize_problem()
 
 	// load default plugins linke separators, heuristics, etc.
 	SCIP_CALL_EXC( SCIPincludeDefaultPlugins( _scip ) );
+	SCIP_CALL_EXC( include_interrupt_eventhdlr( _scip ) );
 
 	// create message handler
 	SCIP_CALL_EXC( SCIPmessagehdlrCreate( &messagehdlr, true, 0, false,
@@ -257,6 +841,10 @@ void flp_solver::initialize_problem()
 	// set verbosity level
 	SCIP_CALL_EXC( SCIPsetIntParam( _scip, "display/verblevel", SCIP_VERBLEVEL_NONE ) );
 
+	// variables and constraints are never looked up by name
+	SCIP_CALL_EXC( SCIPsetBoolParam( _scip, "misc/usevartable", false ) );
+	SCIP_CALL_EXC( SCIPsetBoolParam( _scip, "misc/useconstable", false ) );
+
 	// create an empty problem
 	SCIP_CALL_EXC( SCIPcreateProb( _scip, "flp", 0, 0, 0, 0, 0, 0, 0 ) );
 
@@ -268,15 +856,19 @@ void flp_solver::initialize_variables()
 {
 	int k = _mainobj;
 
-	// create a binary variable for every y(j)
+	_vars.reserve( instance.num_facilities + instance.num_customers * instance.num_facilities );
+
+	// the objective is the main one
+	_weights.assign( instance.num_objectives, 0. );
+	_weights[k] = 1.;
+
+	// create a binary variable for every y(j), names are given by name_model()
 	for ( int j = 0; j < instance.num_facilities; ++j )
 	{
 		SCIP_VAR * var;
-		std::ostringstream namebuf;
-		namebuf << "y[" << j << "]";
 
 		// create the SCIP_VAR object
-		SCIP_CALL_EXC( SCIPcreateVar( _scip, &var, namebuf.str().c_str(), 0.0, 1.0, instance.f[k][j],
+		SCIP_CALL_EXC( SCIPcreateVar( _scip, &var, 0, 0.0, 1.0, instance.f[k][j],
 			( _relaxation ) ? SCIP_VARTYPE_CONTINUOUS : SCIP_VARTYPE_BINARY,
 			true, false, 0, 0, 0, 0, 0 ) );
 
@@ -285,6 +877,7 @@ void flp_solver::initialize_variables()
 
 		// storing the SCIP_VAR pointer for later access
 		_y[j] = var;
+		_vars.push_back( var );
 	}
 
 	// create a binary variable for every x(i,j)
@@ -293,11 +886,9 @@ void flp_solver::initialize_variables()
 		for ( int j = 0; j < instance.num_facilities; ++j )
 		{
 			SCIP_VAR * var;
-			std::ostringstream namebuf;
-			namebuf << "x[" << i << "," << j << "]";
 
 			// create the SCIP_VAR object
-			SCIP_CALL_EXC( SCIPcreateVar( _scip, &var, namebuf.str().c_str(), 0.0, 1.0, instance.c[k][i][j],
+			SCIP_CALL_EXC( SCIPcreateVar( _scip, &var, 0, 0.0, 1.0, instance.c( k, i, j ),
 				( _relaxation || !instance.single_source ) ? SCIP_VARTYPE_CONTINUOUS : SCIP_VARTYPE_BINARY,
 				true, false, 0, 0, 0, 0, 0 ) );
 
@@ -306,28 +897,23 @@ void flp_solver::initialize_variables()
 
 			// storing the SCIP_VAR pointer for later access
 			_x[i][j] = var;
+			_vars.push_back( var );
 		}
 	}
 }
 
 void flp_solver::initialize_assignment_constraints()
 {
+	std::vector<double> ones( instance.num_facilities, 1.0 );
+
 	// assignment constraints
 	for ( int i = 0; i < instance.num_customers; ++i )
 	{
 		SCIP_CONS * cons;
-		std::ostringstream namebuf;
-		namebuf << "assign_" << i;
-
-		// create SCIP_CONS object, this is an equality
-		SCIP_CALL_EXC( SCIPcreateConsLinear( _scip, &cons, namebuf.str().c_str(), 0, 0, 0, 1.0, 1.0,
-			true, true, true, true, true, false, false, false, false, false ) );
 
 		// sum(j=1 to n) x(i,j) = 1
-		for ( int j = 0; j < instance.num_facilities; ++j )
-		{
-			SCIP_CALL_EXC( SCIPaddCoefLinear( _scip, cons, _x[i][j], 1.0 ) );
-		}
+		SCIP_CALL_EXC( SCIPcreateConsLinear( _scip, &cons, "", instance.num_facilities, &_x[i][0], &ones[0], 1.0, 1.0,
+			true, true, true, true, true, false, false, false, false, false ) );
 
 		// add the constraint to scip
 		SCIP_CALL_EXC( SCIPaddCons( _scip, cons ) );
@@ -339,23 +925,23 @@ void flp_solver::initialize_assignment_constraints()
 
 void flp_solver::initialize_opening_constraints()
 {
+	SCIP_Real vals[2] = { 1.0, -1.0 };
+
+	_open_cons.assign( instance.num_customers, std::vector<SCIP_CONS *>( instance.num_facilities, (SCIP_CONS *)0 ) );
+
 	// facility opening constraints
 	for ( int i = 0; i < instance.num_customers; ++i )
 	{
 		for ( int j = 0; j < instance.num_facilities; ++j )
 		{
 			SCIP_CONS * cons;
-			std::ostringstream namebuf;
-			namebuf << "open_" << i << "_" << j;
+			SCIP_VAR * vars[2] = { _x[i][j], _y[j] };
 
 			// x(i,j) <= y(j)
-			SCIP_CALL_EXC( SCIPcreateConsLinear( _scip, &cons, namebuf.str().c_str(), 0, 0, 0,
+			SCIP_CALL_EXC( SCIPcreateConsLinear( _scip, &cons, "", 2, vars, vals,
 				-SCIPinfinity( _scip ), 0.0,
 				true, true, true, true, true, false, false, false, false, false ) );
 
-			SCIP_CALL_EXC( SCIPaddCoefLinear( _scip, cons, _x[i][j], 1.0 ) );
-			SCIP_CALL_EXC( SCIPaddCoefLinear( _scip, cons, _y[j], -1.0 ) );
-
 			// add the constraint to scip
 			SCIP_CALL_EXC( SCIPaddCons( _scip, cons ) );
 
@@ -365,25 +951,79 @@ void flp_solver::initialize_opening_constraints()
 	}
 }
 
-void flp_solver::initialize_capacity_constraints()
+void flp_solver::initialize_lazy_opening_constraints()
 {
-	// capacity constraints
+	int m = instance.num_customers;
+	std::vector<SCIP_VAR *> vars( m + 1 );
+	std::vector<double> vals( m + 1, 1.0 );
+
+	vals[m] = -(double)m;
+	_open_sum_cons.resize( instance.num_facilities );
+
+	// aggregated facility opening constraints
 	for ( int j = 0; j < instance.num_facilities; ++j )
 	{
 		SCIP_CONS * cons;
-		std::ostringstream namebuf;
-		namebuf << "cap_" << j;
 
-		SCIP_CALL_EXC( SCIPcreateConsLinear( _scip, &cons, namebuf.str().c_str(), 0, 0, 0,
+		// sum(i=1 to m) x(i,j) <= m y(j)
+		for ( int i = 0; i < m; ++i )
+		{
+			vars[i] = _x[i][j];
+		}
+		vars[m] = _y[j];
+
+		SCIP_CALL_EXC( SCIPcreateConsLinear( _scip, &cons, "", m + 1, &vars[0], &vals[0],
 			-SCIPinfinity( _scip ), 0.0,
 			true, true, true, true, true, false, false, false, false, false ) );
 
+		// add the constraint to scip
+		SCIP_CALL_EXC( SCIPaddCons( _scip, cons ) );
+
+		// storing the SCIP_CONS pointer for later access
+		_open_sum_cons[j] = cons;
+	}
+
+	// x(i,j) <= y(j), separated on demand
+	{
+		SCIP_CONS * cons;
+
+		SCIP_CALL_EXC( include_opening_conshdlr( _scip ) );
+		SCIP_CALL_EXC( create_opening_cons( _scip, &cons, "open", m, instance.num_facilities,
+			&_vars[instance.num_facilities], &_y[0] ) );
+
+		// add the constraint to scip
+		SCIP_CALL_EXC( SCIPaddCons( _scip, cons ) );
+	}
+
+	// the handler has no copy callback, so the heuristics and separators
+	// solving a copy of the problem would miss the opening constraints
+	SCIP_CALL_EXC( SCIPsetSubscipsOff( _scip, TRUE ) );
+}
+
+void flp_solver::initialize_capacity_constraints()
+{
+	int m = instance.num_customers;
+	std::vector<SCIP_VAR *> vars( m + 1 );
+	std::vector<double> vals( instance.d.begin(), instance.d.end() );
+
+	vals.push_back( 0. );
+
+	// capacity constraints
+	for ( int j = 0; j < instance.num_facilities; ++j )
+	{
+		SCIP_CONS * cons;
+
 		// sum(i=1 to m) d(i) x(i,j) <= q(j) y(j)
-		for ( int i = 0; i < instance.num_customers; ++i )
+		for ( int i = 0; i < m; ++i )
 		{
-			SCIP_CALL_EXC( SCIPaddCoefLinear( _scip, cons, _x[i][j], instance.d[i] ) );
+			vars[i] = _x[i][j];
 		}
-		SCIP_CALL_EXC( SCIPaddCoefLinear( _scip, cons, _y[j], -instance.q[j] ) );
+		vars[m] = _y[j];
+		vals[m] = -instance.q[j];
+
+		SCIP_CALL_EXC( SCIPcreateConsLinear( _scip, &cons, "", m + 1, &vars[0], &vals[0],
+			-SCIPinfinity( _scip ), 0.0,
+			true, true, true, true, true, false, false, false, false, false ) );
 
 		// add the constraint to scip
 		SCIP_CALL_EXC( SCIPaddCons( _scip, cons ) );
@@ -395,20 +1035,18 @@ void flp_solver::initialize_capacity_constraints()
 
 void flp_solver::initialize_valid_inequalities()
 {
+	int n = instance.num_facilities, mn = instance.num_customers * n;
+
 	// demand covering
 	{
 		SCIP_CONS * cons;
+		std::vector<double> vals( instance.q.begin(), instance.q.end() );
 
-		SCIP_CALL_EXC( SCIPcreateConsLinear( _scip, &cons, "cover", 0, 0, 0,
+		// sum(j=1 to n) q(j) y(j) >= sum(i=1 to m) d(i)
+		SCIP_CALL_EXC( SCIPcreateConsLinear( _scip, &cons, "cover", n, &_y[0], &vals[0],
 			instance.D, SCIPinfinity( _scip ),
 			true, true, true, true, true, false, false, false, false, false ) );
 
-		// sum(j=1 to n) q(j) y(j) >= sum(i=1 to m) d(i)
-		for ( int j = 0; j < instance.num_facilities; ++j )
-		{
-			SCIP_CALL_EXC( SCIPaddCoefLinear( _scip, cons, _y[j], instance.q[j] ) );
-		}
-
 		// add the constraint to scip
 		SCIP_CALL_EXC( SCIPaddCons( _scip, cons ) );
 	}
@@ -416,20 +1054,18 @@ void flp_solver::initialize_valid_inequalities()
 	// demand limit
 	{
 		SCIP_CONS * cons;
+		std::vector<double> vals( mn );
 
-		SCIP_CALL_EXC( SCIPcreateConsLinear( _scip, &cons, "limit", 0, 0, 0,
-			-SCIPinfinity( _scip ), instance.D,
-			true, true, true, true, true, false, false, false, false, false ) );
-
-		// sum(i=1 to m) sum(j=1 to n) d(i) x(i,j) <= sum(i=1 to m) d(i)
-		for ( int i = 0; i < instance.num_customers; ++i )
+		for ( int ij = 0; ij < mn; ++ij )
 		{
-			for ( int j = 0; j < instance.num_facilities; ++j )
-			{
-				SCIP_CALL_EXC( SCIPaddCoefLinear( _scip, cons, _x[i][j], instance.d[i] ) );
-			}
+			vals[ij] = instance.d[ij / n];
 		}
 
+		// sum(i=1 to m) sum(j=1 to n) d(i) x(i,j) <= sum(i=1 to m) d(i)
+		SCIP_CALL_EXC( SCIPcreateConsLinear( _scip, &cons, "limit", mn, &_vars[n], &vals[0],
+			-SCIPinfinity( _scip ), instance.D,
+			true, true, true, true, true, false, false, false, false, false ) );
+
 		// add the constraint to scip
 		SCIP_CALL_EXC( SCIPaddCons( _scip, cons ) );
 	}
@@ -468,32 +1104,139 @@ void flp_solver::initialize_valid_inequalities()
 void flp_solver::initialize_epsilon_constraints()
 {
 	SCIP_CONS * cons;
-	int k = _mainobj == 0 ? 1 : 0;
+	std::vector<double> vals;
+
+	// epsilon constraint on every other objective, objective <= epsilon
+	for ( int l = 0; l < instance.num_objectives; ++l )
+	{
+		_epsilon_cons[l] = 0;
+
+		if ( l == _mainobj )
+			continue;
+
+		objective_coefficients( l, vals );
+
+		SCIP_CALL_EXC( SCIPcreateConsLinear( _scip, &cons, "epsilon", (int)_vars.size(), &_vars[0], &vals[0],
+			-SCIPinfinity( _scip ), SCIPinfinity( _scip ),
+			true, true, true, true, true, false, false, false, false, false ) );
+
+		// add the constraint to scip
+		SCIP_CALL_EXC( SCIPaddCons( _scip, cons ) );
+
+		// storing the SCIP_CONS pointer for later access
+		_epsilon_cons[l] = cons;
+	}
+
+	// lower bound on main objective, separated only when violated, objective >= bound
+	epsilon_coefficients( vals );
 
-	// epsilon constraint on second objective
-	SCIP_CALL_EXC( SCIPcreateConsLinear( _scip, &cons, "epsilon", 0, 0, 0,
+	SCIP_CALL_EXC( SCIPcreateConsLinear( _scip, &cons, "bound", (int)_vars.size(), &_vars[0], &vals[0],
 		-SCIPinfinity( _scip ), SCIPinfinity( _scip ),
-		true, true, true, true, true, false, false, false, false, false ) );
+		false, true, true, true, true, false, false, false, false, false ) );
 
-	// objective <= epsilon
-	for ( int j = 0; j < instance.num_facilities; ++j )
+	// add the constraint to scip
+	SCIP_CALL_EXC( SCIPaddCons( _scip, cons ) );
+
+	// storing the SCIP_CONS pointer for later access
+	_bound_cons = cons;
+}
+
+void flp_solver::objective_coefficients( int k, std::vector<double> & obj ) const
+{
+	int n = instance.num_facilities;
+
+	obj.resize( _vars.size() );
+
+	// objective of y(j)
+	std::copy( instance.f[k].begin(), instance.f[k].end(), obj.begin() );
+
+	// objective of x(i,j), costs and variables share the same layout
+	std::copy( instance.c_objective( k ), instance.c_objective( k ) + instance.num_customers * n, obj.begin() + n );
+}
+
+void flp_solver::epsilon_coefficients( std::vector<double> & obj ) const
+{
+	objective_coefficients( _mainobj, obj );
+
+	if ( _augmentation == 0. )
+		return;
+
+	std::vector<double> other;
+
+	for ( int l = 0; l < instance.num_objectives; ++l )
+	{
+		if ( l == _mainobj )
+			continue;
+
+		objective_coefficients( l, other );
+
+		for ( std::size_t v = 0; v < obj.size(); ++v )
+		{
+			obj[v] += _augmentation * other[v];
+		}
+	}
+}
+
+void flp_solver::name_model() const
+{
+	int n = instance.num_facilities;
+
+	// names can only be changed in problem stage
+	if ( _named || SCIPgetStage( _scip ) != SCIP_STAGE_PROBLEM )
+		return;
+
+	for ( int j = 0; j < n; ++j )
 	{
-		SCIP_CALL_EXC( SCIPaddCoefLinear( _scip, cons, _y[j], instance.f[k][j] ) );
+		std::ostringstream namebuf;
+		namebuf << "y[" << j << "]";
+		SCIP_CALL_EXC( SCIPchgVarName( _scip, _y[j], namebuf.str().c_str() ) );
 	}
 
 	for ( int i = 0; i < instance.num_customers; ++i )
 	{
-		for ( int j = 0; j < instance.num_facilities; ++j )
+		for ( int j = 0; j < n; ++j )
 		{
-			SCIP_CALL_EXC( SCIPaddCoefLinear( _scip, cons, _x[i][j], instance.c[k][i][j] ) );
+			std::ostringstream namebuf;
+			namebuf << "x[" << i << "," << j << "]";
+			SCIP_CALL_EXC( SCIPchgVarName( _scip, _x[i][j], namebuf.str().c_str() ) );
 		}
 	}
 
-	// add the constraint to scip
-	SCIP_CALL_EXC( SCIPaddCons( _scip, cons ) );
+	for ( int i = 0; i < instance.num_customers; ++i )
+	{
+		std::ostringstream namebuf;
+		namebuf << "assign_" << i;
+		SCIP_CALL_EXC( SCIPchgConsName( _scip, _assign_cons[i], namebuf.str().c_str() ) );
+	}
 
-	// storing the SCIP_CONS pointer for later access
-	_epsilon_cons = cons;
+	for ( int i = 0; i < (int)_open_cons.size(); ++i )
+	{
+		for ( int j = 0; j < n; ++j )
+		{
+			std::ostringstream namebuf;
+			namebuf << "open_" << i << "_" << j;
+			SCIP_CALL_EXC( SCIPchgConsName( _scip, _open_cons[i][j], namebuf.str().c_str() ) );
+		}
+	}
+
+	for ( int j = 0; j < (int)_open_sum_cons.size(); ++j )
+	{
+		std::ostringstream namebuf;
+		namebuf << "open_" << j;
+		SCIP_CALL_EXC( SCIPchgConsName( _scip, _open_sum_cons[j], namebuf.str().c_str() ) );
+	}
+
+	if ( instance.capacitated )
+	{
+		for ( int j = 0; j < n; ++j )
+		{
+			std::ostringstream namebuf;
+			namebuf << "cap_" << j;
+			SCIP_CALL_EXC( SCIPchgConsName( _scip, _cap_cons[j], namebuf.str().c_str() ) );
+		}
+	}
+
+	_named = true;
 }
 
 void flp_solver::store_dual()
@@ -517,13 +1260,23 @@ void flp_solver::store_dual()
 		}
 	}
 
-	for ( int i = 0; i < instance.num_customers; ++i )
+	_open_dual.clear();
+
+	for ( int i = 0; i < (int)_open_cons.size(); ++i )
 	{
 		for ( int j = 0; j < instance.num_facilities; ++j )
 		{
-    			SCIPgetTransformedCons( _scip, _open_cons[i][j], &transformed );
-			if ( transformed )
-				_open_dual[i][j] = SCIPgetDualsolLinear( _scip, transformed );
+			// x(i,j) < y(j): by complementary slackness the dual is 0
+			if ( _relaxation && !_values.empty() && x_real( i, j ) < y_real( j ) - 1e-9 )
+				continue;
+
+			SCIPgetTransformedCons( _scip, _open_cons[i][j], &transformed );
+			if ( !transformed )
+				continue;
+
+			double dual = SCIPgetDualsolLinear( _scip, transformed );
+			if ( dual != 0. )
+				_open_dual.push_back( std::make_pair( i*instance.num_facilities + j, dual ) );
 		}
 	}
 }
@@ -0,0 +1,54 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "interrupt_eventhdlr.hpp"
+#include "budget.hpp"
+
+#define EVENTHDLR_NAME "interrupt"
+#define EVENTHDLR_DESC "interrupt the solve on SIGINT or SIGTERM"
+#define EVENTHDLR_TYPE ( SCIP_EVENTTYPE_NODESOLVED | SCIP_EVENTTYPE_LPSOLVED )
+
+static SCIP_DECL_EVENTEXEC(eventExecInterrupt)
+{
+	if ( budget::signaled() && !SCIPisStopped( scip ) )
+	{
+		SCIP_CALL( SCIPinterruptSolve( scip ) );
+	}
+	return SCIP_OKAY;
+}
+
+static SCIP_DECL_EVENTINITSOL(eventInitsolInterrupt)
+{
+	SCIP_CALL( SCIPcatchEvent( scip, EVENTHDLR_TYPE, eventhdlr, 0, 0 ) );
+	return SCIP_OKAY;
+}
+
+static SCIP_DECL_EVENTEXITSOL(eventExitsolInterrupt)
+{
+	SCIP_CALL( SCIPdropEvent( scip, EVENTHDLR_TYPE, eventhdlr, 0, -1 ) );
+	return SCIP_OKAY;
+}
+
+SCIP_RETCODE include_interrupt_eventhdlr( SCIP * scip )
+{
+	SCIP_EVENTHDLR * eventhdlr;
+
+	SCIP_CALL( SCIPincludeEventhdlrBasic( scip, &eventhdlr, EVENTHDLR_NAME, EVENTHDLR_DESC,
+		eventExecInterrupt, 0 ) );
+	SCIP_CALL( SCIPsetEventhdlrInitsol( scip, eventhdlr, eventInitsolInterrupt ) );
+	SCIP_CALL( SCIPsetEventhdlrExitsol( scip, eventhdlr, eventExitsolInterrupt ) );
+
+	return SCIP_OKAY;
+}
@@ -0,0 +1,61 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "json.hpp"
+#include <limits>
+
+void write_json_string( std::ostream & os, const std::string & value )
+{
+	static const char hex[] = "0123456789abcdef";
+
+	os << '"';
+	for ( std::size_t i = 0; i < value.size(); ++i )
+	{
+		unsigned char c = value[i];
+
+		if ( c == '"' || c == '\\' )
+			os << '\\' << c;
+		else if ( c < 0x20 )
+			os << "\\u00" << hex[c >> 4] << hex[c & 0xf];
+		else
+			os << c;
+	}
+	os << '"';
+}
+
+void write_json_number( std::ostream & os, double value )
+{
+	if ( value != value || value == std::numeric_limits<double>::infinity()
+		|| value == -std::numeric_limits<double>::infinity() )
+	{
+		os << "null";
+	}
+	else
+	{
+		os << value;
+	}
+}
+
+void write_json_array( std::ostream & os, const double * values, std::size_t size )
+{
+	os << '[';
+	for ( std::size_t i = 0; i < size; ++i )
+	{
+		if ( i > 0 )
+			os << ',';
+		write_json_number( os, values[i] );
+	}
+	os << ']';
+}
@@ -0,0 +1,266 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "lagrangian.hpp"
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+lagrangian::lagrangian( const problem & instance ) :
+	_instance( instance ),
+	_cost(),
+	_fixed(),
+	_u(),
+	_x(),
+	_value(),
+	_items()
+{
+}
+
+double lagrangian::bound( const std::vector<double> & weights, double target, int iterations )
+{
+	const double infinity = std::numeric_limits<double>::infinity();
+	int m = _instance.num_customers, n = _instance.num_facilities;
+	std::vector<double> u, best_u, subgradient;
+
+	// weighted costs, in the layout of problem::c_objective
+	_cost.assign( (std::size_t)m * n, 0. );
+	_fixed.assign( n, 0. );
+
+	for ( int k = 0; k < _instance.num_objectives; ++k )
+	{
+		const double * c = _instance.c_objective( k );
+
+		if ( weights[k] == 0. )
+			continue;
+
+		for ( std::size_t ij = 0; ij < _cost.size(); ++ij )
+		{
+			_cost[ij] += weights[k] * c[ij];
+		}
+
+		for ( int j = 0; j < n; ++j )
+		{
+			_fixed[j] += weights[k] * _instance.f[k][j];
+		}
+	}
+
+	// without a warm start, each customer is worth its cheapest assignment
+	if ( (int)_u.size() != m )
+	{
+		_u.assign( m, 0. );
+		for ( int i = 0; i < m && n > 0; ++i )
+		{
+			_u[i] = *std::min_element( &_cost[(std::size_t)i * n], &_cost[(std::size_t)i * n] + n );
+		}
+	}
+
+	_x.resize( (std::size_t)m * n );
+	_value.resize( n );
+
+	u = _u;
+	best_u = u;
+
+	double best = -infinity, alpha = 2.;
+	int stall = 0;
+
+	for ( int iteration = 0; iteration < iterations; ++iteration )
+	{
+		double value = evaluate( u, subgradient );
+
+		// no facilities can cover the demand
+		if ( value == infinity )
+			return value;
+
+		if ( value > best )
+		{
+			best = value;
+			best_u = u;
+			stall = 0;
+		}
+		else if ( ++stall >= 10 )
+		{
+			// halve the steps when the bound stalls
+			alpha /= 2.;
+			stall = 0;
+		}
+
+		if ( target < infinity && best >= target - tolerance() )
+			break;
+
+		double norm = 0.;
+		for ( int i = 0; i < m; ++i )
+		{
+			norm += subgradient[i] * subgradient[i];
+		}
+
+		// the relaxed solution assigns every customer once: it is optimal
+		if ( norm < 1e-12 || alpha < 1e-4 )
+			break;
+
+		// Polyak step towards the target, or a guess above the best bound
+		double goal = ( target < infinity ? target : best + 0.05 * std::max( 1., std::fabs( best ) ) );
+		double step = alpha * ( goal - value ) / norm;
+
+		for ( int i = 0; i < m; ++i )
+		{
+			u[i] += step * subgradient[i];
+		}
+	}
+
+	_u = best_u;
+	return best;
+}
+
+void lagrangian::set_multipliers( const std::vector<double> & u )
+{
+	_u = u;
+}
+
+double lagrangian::tolerance()
+{
+	return 1e-9;
+}
+
+double lagrangian::evaluate( const std::vector<double> & u, std::vector<double> & subgradient )
+{
+	int m = _instance.num_customers, n = _instance.num_facilities;
+	std::vector<double> y( n, 0. );
+	double value = 0., capacity = 0.;
+	bool open = false;
+
+	for ( int i = 0; i < m; ++i )
+	{
+		value += u[i];
+	}
+
+	// value of each facility if it is open
+	for ( int j = 0; j < n; ++j )
+	{
+		if ( _instance.capacitated )
+		{
+			_value[j] = knapsack( j, u );
+			continue;
+		}
+
+		_value[j] = _fixed[j];
+		for ( int i = 0; i < m; ++i )
+		{
+			double reduced = _cost[(std::size_t)i * n + j] - u[i];
+
+			_x[(std::size_t)i * n + j] = ( reduced < 0. ? 1. : 0. );
+			_value[j] += std::min( 0., reduced );
+		}
+	}
+
+	// open the facilities of negative value
+	for ( int j = 0; j < n; ++j )
+	{
+		if ( _value[j] < 0. )
+		{
+			y[j] = 1.;
+			capacity += _instance.q[j];
+			open = true;
+		}
+	}
+
+	if ( !_instance.capacitated && m > 0 && n > 0 && !open )
+	{
+		// at least one facility is open
+		y[std::min_element( _value.begin(), _value.end() ) - _value.begin()] = 1.;
+	}
+	else if ( _instance.capacitated && capacity < _instance.D )
+	{
+		// the open facilities cover the demand: continuous covering knapsack
+		_items.clear();
+		for ( int j = 0; j < n; ++j )
+		{
+			if ( y[j] == 0. && _instance.q[j] > 0. )
+				_items.push_back( std::make_pair( _value[j] / _instance.q[j], j ) );
+		}
+		std::sort( _items.begin(), _items.end() );
+
+		for ( std::size_t item = 0; item < _items.size() && capacity < _instance.D; ++item )
+		{
+			int j = _items[item].second;
+
+			y[j] = std::min( 1., ( _instance.D - capacity ) / _instance.q[j] );
+			capacity += y[j] * _instance.q[j];
+		}
+
+		if ( capacity < _instance.D * ( 1. - 1e-9 ) )
+			return std::numeric_limits<double>::infinity();
+	}
+
+	subgradient.assign( m, 1. );
+
+	for ( int j = 0; j < n; ++j )
+	{
+		if ( y[j] == 0. )
+			continue;
+
+		value += y[j] * _value[j];
+
+		for ( int i = 0; i < m; ++i )
+		{
+			subgradient[i] -= y[j] * _x[(std::size_t)i * n + j];
+		}
+	}
+
+	return value;
+}
+
+double lagrangian::knapsack( int j, const std::vector<double> & u )
+{
+	int m = _instance.num_customers, n = _instance.num_facilities;
+	double value = _fixed[j], capacity = _instance.q[j];
+
+	// customers with a negative reduced cost, by reduced cost per unit of demand
+	_items.clear();
+
+	for ( int i = 0; i < m; ++i )
+	{
+		double reduced = _cost[(std::size_t)i * n + j] - u[i];
+
+		_x[(std::size_t)i * n + j] = 0.;
+
+		if ( reduced >= 0. )
+			continue;
+
+		if ( _instance.d[i] <= 0. )
+		{
+			_x[(std::size_t)i * n + j] = 1.;
+			value += reduced;
+		}
+		else
+		{
+			_items.push_back( std::make_pair( reduced / _instance.d[i], i ) );
+		}
+	}
+
+	std::sort( _items.begin(), _items.end() );
+
+	for ( std::size_t item = 0; item < _items.size() && capacity > 0.; ++item )
+	{
+		int i = _items[item].second;
+		double amount = std::min( 1., capacity / _instance.d[i] );
+
+		_x[(std::size_t)i * n + j] = amount;
+		value += amount * ( _cost[(std::size_t)i * n + j] - u[i] );
+		capacity -= amount * _instance.d[i];
+	}
+
+	return value;
+}
@@ -0,0 +1,350 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "lower_bound_set.hpp"
+#include <algorithm>
+#include <utility>
+#include <limits>
+
+namespace
+{
+	const double infinity = std::numeric_limits<double>::infinity();
+
+	// A line u = m t + q
+	typedef std::pair<double, double> line;
+
+	/*
+		Function: intersection
+
+		Return t such that both lines are equal, slopes being different.
+	*/
+	double intersection( const line & l1, const line & l2 )
+	{
+		return ( l2.second - l1.second ) / ( l1.first - l2.first );
+	}
+
+	/*
+		Function: upper_envelope
+
+		Keep only the lines reaching the maximum for some t, sorted by
+		increasing slopes, i.e. from left to right.
+	*/
+	void upper_envelope( std::vector<line> & lines )
+	{
+		std::vector<line> envelope;
+
+		std::sort( lines.begin(), lines.end() );
+
+		for ( std::size_t index = 0; index < lines.size(); ++index )
+		{
+			const line & l = lines[index];
+
+			// same slope: the last one has the greatest intercept
+			if ( index + 1 < lines.size() && lines[index + 1].first == l.first )
+				continue;
+
+			while ( envelope.size() >= 2
+				&& intersection( envelope[envelope.size() - 2], l )
+					<= intersection( envelope[envelope.size() - 2], envelope.back() ) )
+			{
+				envelope.pop_back();
+			}
+			envelope.push_back( l );
+		}
+
+		lines.swap( envelope );
+	}
+
+	/*
+		Function: evaluate
+
+		Return the maximum of the lines at t.
+	*/
+	double evaluate( const std::vector<line> & lines, double t )
+	{
+		double value = -infinity;
+		for ( std::size_t index = 0; index < lines.size(); ++index )
+		{
+			value = std::max( value, lines[index].first * t + lines[index].second );
+		}
+		return value;
+	}
+
+	/*
+		Function: positive_area
+
+		Integrate the positive part of a linear function over an interval.
+
+		Parameters:
+			hs - The value at the beginning of the interval.
+			he - The value at the end of the interval.
+			width - The width of the interval.
+	*/
+	double positive_area( double hs, double he, double width )
+	{
+		if ( hs >= 0. && he >= 0. )
+			return ( hs + he ) / 2. * width;
+		if ( hs <= 0. && he <= 0. )
+			return 0.;
+		if ( hs > 0. )
+			return hs * hs / ( hs - he ) / 2. * width;
+		return he * he / ( he - hs ) / 2. * width;
+	}
+}
+
+lower_bound_set::lower_bound_set() :
+	_halfspaces(),
+	_boxes()
+{
+	_nadir[0] = _nadir[1] = infinity;
+}
+
+void lower_bound_set::add_weighted_sum( int k, double lambda, double bound )
+{
+	halfspace h;
+	h.a[k] = 1. - lambda;
+	h.a[1 - k] = lambda;
+	h.b = bound;
+
+	lock_guard guard( _lock );
+	_halfspaces.push_back( h );
+}
+
+void lower_bound_set::add_epsilon_constraint( int k, double lower, double epsilon, double bound )
+{
+	box b;
+	b.k = k;
+	b.lower = lower;
+	b.upper = epsilon;
+	b.bound = bound;
+
+	lock_guard guard( _lock );
+	_boxes.push_back( b );
+}
+
+void lower_bound_set::add_nadir_bound( int k, double bound )
+{
+	lock_guard guard( _lock );
+	_nadir[k] = std::min( _nadir[k], bound );
+}
+
+void lower_bound_set::clear()
+{
+	lock_guard guard( _lock );
+	_halfspaces.clear();
+	_boxes.clear();
+	_nadir[0] = _nadir[1] = infinity;
+}
+
+double lower_bound_set::gap( const archive & front ) const
+{
+	lock_guard guard( _lock );
+
+	if ( front.empty() )
+		return infinity;
+
+	// z(k) is bounded from below as a function of t = z(l); implications of
+	// the other orientation are ignored, which keeps the bound valid
+	int k = _boxes.empty() ? 0 : _boxes[0].k, l = 1 - k;
+	double ru = _nadir[k], rt = _nadir[l], tmin = -infinity;
+	double tfront = -infinity, ufront = infinity;
+	std::vector<line> lines;
+
+	// the point of the front of greatest z(l) has the least z(k)
+	for ( int index = 0; index < front.size(); ++index )
+	{
+		ru = std::max( ru, front[index][k] );
+		tfront = std::max( tfront, front[index][l] );
+		ufront = std::min( ufront, front[index][k] );
+	}
+
+	for ( std::size_t index = 0; index < _halfspaces.size(); ++index )
+	{
+		const halfspace & h = _halfspaces[index];
+
+		if ( h.b == -infinity )
+			continue;
+		if ( h.b == infinity )
+			return 0.;
+
+		if ( h.a[k] > 0. )
+			lines.push_back( line( -h.a[l] / h.a[k], h.b / h.a[k] ) );
+		else if ( h.a[l] > 0. )
+			tmin = std::max( tmin, h.b / h.a[l] );
+	}
+
+	upper_envelope( lines );
+
+	// below tstart, no point can be missing
+	double tstart = tmin;
+
+	if ( tstart == -infinity )
+	{
+		for ( std::size_t index = 0; index < lines.size(); ++index )
+		{
+			if ( lines[index].first < 0. )
+				tstart = std::max( tstart, ( ru - lines[index].second ) / lines[index].first );
+			else if ( lines[index].first == 0. && lines[index].second >= ru )
+				return 0.;
+		}
+
+		for ( std::size_t index = 0; index < _boxes.size(); ++index )
+		{
+			const box & b = _boxes[index];
+			if ( b.k == k && b.lower == -infinity && b.bound >= ru )
+				tstart = std::max( tstart, b.upper );
+		}
+
+		if ( tstart == -infinity )
+			return infinity;
+	}
+
+	// the integrand is linear between two breakpoints
+	std::vector<double> breakpoints;
+	breakpoints.push_back( tstart );
+
+	for ( int index = 0; index < front.size(); ++index )
+	{
+		breakpoints.push_back( front[index][l] );
+	}
+
+	for ( std::size_t index = 0; index < _boxes.size(); ++index )
+	{
+		breakpoints.push_back( _boxes[index].lower );
+		breakpoints.push_back( _boxes[index].upper );
+	}
+
+	for ( std::size_t index = 0; index + 1 < lines.size(); ++index )
+	{
+		breakpoints.push_back( intersection( lines[index], lines[index + 1] ) );
+	}
+
+	// without a nadir bound of z(l), the region beyond the last breakpoint
+	// is below ufront and above the bounds valid for any large z(l)
+	if ( rt == infinity )
+	{
+		double tail = -infinity;
+
+		for ( std::size_t index = 0; index < breakpoints.size(); ++index )
+		{
+			if ( breakpoints[index] < infinity )
+				rt = ( rt == infinity ? breakpoints[index] : std::max( rt, breakpoints[index] ) );
+		}
+
+		for ( std::size_t index = 0; index < _boxes.size(); ++index )
+		{
+			if ( _boxes[index].k == k && _boxes[index].lower <= rt && _boxes[index].upper == infinity )
+				tail = std::max( tail, _boxes[index].bound );
+		}
+
+		if ( !lines.empty() && lines.back().first == 0. )
+			tail = std::max( tail, lines.back().second );
+
+		if ( tail < ufront )
+			return infinity;
+	}
+
+	rt = std::max( rt, tfront );
+
+	if ( tstart >= rt )
+		return 0.;
+
+	breakpoints.push_back( rt );
+	std::sort( breakpoints.begin(), breakpoints.end() );
+	breakpoints.erase( std::unique( breakpoints.begin(), breakpoints.end() ), breakpoints.end() );
+
+	double area = 0.;
+
+	for ( std::size_t index = 0; index + 1 < breakpoints.size(); ++index )
+	{
+		double s = breakpoints[index], e = breakpoints[index + 1], mid = ( s + e ) / 2.;
+
+		if ( s < tstart || e > rt )
+			continue;
+
+		// upper limit: not dominated by the front
+		double u = ru;
+		for ( int p = 0; p < front.size(); ++p )
+		{
+			if ( front[p][l] <= mid )
+				u = std::min( u, front[p][k] );
+		}
+
+		// lower limit of the implications
+		double lb = -infinity;
+		for ( std::size_t b = 0; b < _boxes.size(); ++b )
+		{
+			if ( _boxes[b].k == k && _boxes[b].lower <= mid && mid <= _boxes[b].upper )
+				lb = std::max( lb, _boxes[b].bound );
+		}
+
+		// an infeasible box leaves nothing to find, even below the front
+		if ( lb == infinity )
+			continue;
+
+		double c = u - lb;
+
+		if ( c <= 0. )
+			continue;
+
+		// below the front, z(k) is only bounded by the nadir bound
+		if ( u == infinity )
+			return infinity;
+
+		if ( lines.empty() )
+		{
+			if ( c == infinity )
+				return infinity;
+			area += c * ( e - s );
+			continue;
+		}
+
+		// width = min( u - lines, c ), split where both are equal
+		double gs = u - evaluate( lines, s ), ge = u - evaluate( lines, e );
+
+		if ( c != infinity && ( gs - c ) * ( ge - c ) < 0. )
+		{
+			double tc = s + ( c - gs ) / ( ge - gs ) * ( e - s );
+			area += positive_area( std::min( gs, c ), c, tc - s );
+			area += positive_area( c, std::min( ge, c ), e - tc );
+		}
+		else
+		{
+			area += positive_area( std::min( gs, c ), std::min( ge, c ), e - s );
+		}
+	}
+
+	return area;
+}
+
+double lower_bound_set::hypervolume( const archive & front )
+{
+	double r0 = -infinity, r1 = -infinity, volume = 0.;
+
+	for ( int index = 0; index < front.size(); ++index )
+	{
+		r0 = std::max( r0, front[index][0] );
+		r1 = std::max( r1, front[index][1] );
+	}
+
+	// z(0) is increasing and z(1) decreasing along the archive
+	for ( int index = 0; index < front.size(); ++index )
+	{
+		double next = ( index + 1 < front.size() ) ? front[index + 1][0] : r0;
+		volume += ( next - front[index][0] ) * ( r1 - front[index][1] );
+	}
+
+	return volume;
+}
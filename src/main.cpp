@@ -16,140 +16,36 @@
 #include "problem.hpp"
 #include "flp_solver.hpp"
 #include "argument.hpp"
+#include "archive.hpp"
+#include "methods.hpp"
+#include "reader.hpp"
+#include "binary.hpp"
+#include "timer.hpp"
+#include "trace.hpp"
+#include "budget.hpp"
+#include "lower_bound_set.hpp"
+#include "checkpoint.hpp"
+#include "batch.hpp"
+#include "server.hpp"
+#include "output.hpp"
+#include "solution_store.hpp"
+#include "candidate_pool.hpp"
 #include <iostream>
-#include <fstream>
-#include <vector>
-#include <queue>
-#include <list>
-#include <utility>
-#include <algorithm>
+#include <memory>
+#include <limits>
 #include <ctime>
 
-/*
-	Function: lexicographic
-
-	Get the lexicographic solutions of a problem.
-
-	Parameters:
-		solve - A flp_solver instance.
-
-	Returns:
-		A set of lexicographic solutions.
-*/
-std::list< std::vector<double> > lexicographic( flp_solver & solve );
-
-/*
-	Function: weighted_sum
-
-	Get the solution of a weighted sum.
-
-	Parameters:
-		solve - A flp_solver instance.
-
-	Returns:
-		A set of one solution.
-*/
-std::list< std::vector<double> > weighted_sum( flp_solver & solve );
-
-/*
-	Function: dichotomic_method
-
-	Get the supported solutions of a problem using a dichotomic method.
-
-	Parameters:
-		solve - A flp_solver instance.
-
-	Returns:
-		A set of supported solutions.
-*/
-std::list< std::vector<double> > dichotomic_method( flp_solver & solve );
-
-/*
-	Function: epsilon_constraint
-
-	Apply epsilon-constraint method to a problem.
-
-	Parameters:
-		solve - A flp_solver instance.
-
-	Returns:
-		A set of efficient solutions.
-*/
-std::list< std::vector<double> > epsilon_constraint( flp_solver & solve );
-
-/*
-	Function: display_solution
-
-	Display the x and y values to the terminal.
-
-	Parameters:
-		solve - A flp_solver instance.
-		os - An output stream.
-*/
-void display_solution( const flp_solver & solve, std::ostream & os );
-
-/*
-	Function: display
-
-	Display a point to the terminal.
-
-	Parameters:
-		z - A point.
-		os - An output stream.
-*/
-void display( const std::vector<double> & z, std::ostream & os );
-
-/*
-	Function: display
-
-	Display the Pareto front to the terminal.
-
-	Parameters:
-		pareto_front - A Pareto front.
-		os - An output stream.
-*/
-void display( const std::list< std::vector<double> > & pareto_front, std::ostream & os );
-
-/*
-	Function: display_last
-
-	Display the last solution to the terminal if verbose mode is enabled.
-
-	Parameters:
-		solve - A flp_solver instance.
-		pareto_front - A Pareto front.
-		os - An output stream.
-*/
-void display_last( const flp_solver & solve, const std::list< std::vector<double> > & pareto_front, std::ostream & os );
-
-/*
-	Function: predicate_is_dominated
-
-	Return true if point is dominated in the Pareto front, false otherwise.
-
-	Parameters:
-		z - A point.
-*/
-struct predicate_is_dominated
-{
-	const std::list< std::vector<double> > & s;
-	predicate_is_dominated( const std::list< std::vector<double> > & s ) : s( s ) {}
-	bool operator () ( const std::vector<double> & z ) const;
-};
-
-////////////////////////////////////////////////////////////////////////////////
-
 int main( int argc, char * argv[] )
 {
-	std::list< std::vector<double> > pareto_front;
-	std::ifstream file;
-	std::time_t t_start, t_end;
+	archive pareto_front;
+	std::clock_t cpu_start, cpu_end;
+	timer wall;
 
 	// Parse program options
 	argument::parse( argc, argv );
 
 	// Print usage
-	if ( argument::filename.empty() || argument::help )
+	if ( ( argument::filename.empty() && argument::batch_file.empty() && !argument::serve ) || argument::help )
 	{
 		argument::usage( argv[0] );
 		return 0;
@@ -161,276 +57,279 @@ int main( int argc, char * argv[] )
 		argument::print( std::clog );
 	}
 
-	// Try to open the file
-	file.open( argument::filename.c_str() );
-	if ( !file.is_open() )
+	if ( argument::objectives > 2 && !argument::efficient )
 	{
-		std::cerr << "Error: unable to open '" << argument::filename << "'" << std::endl;
+		std::cerr << "Error: only --efficient supports more than two objectives" << std::endl;
 		return 0;
 	}
 
-	// Parse the instance
-	if ( argument::verbose )
+	if ( argument::resume && argument::checkpoint_file.empty() )
 	{
-		std::clog << "Parsing " << argument::filename << "..." << std::endl;
+		std::cerr << "Error: --resume requires --checkpoint" << std::endl;
+		return 0;
 	}
 
-	problem instance( (bool)argument::capacitated, (bool)argument::single_source );
-	file >> instance;
+	// Server mode: the instances come with the requests
+	if ( argument::serve )
+	{
+		std::auto_ptr<trace_writer> trace;
 
-	// Begin benchmark
-	t_start = std::clock();
+		if ( !argument::checkpoint_file.empty() )
+		{
+			std::cerr << "Error: --checkpoint is not supported in server mode" << std::endl;
+			return 0;
+		}
 
-	// Solve
-	if ( argument::verbose )
-	{
-		std::clog << "Solving..." << std::endl;
-	}
+		budget::catch_signals();
 
-	// Initialize solver
-	flp_solver solve( instance, argument::relaxation );
-	solve.set_verblevel( argument::verblevel );
+		// The points are only written with the responses
+		argument::verbose = 0;
 
-	if ( argument::efficient )
-	{
-		pareto_front = epsilon_constraint( solve );
-	}
-	else if ( argument::supported )
-	{
-		pareto_front = dichotomic_method( solve );
-	}
-	else if ( argument::weighted_sum )
-	{
-		pareto_front = weighted_sum( solve );
-	}
-	else if ( argument::lexicographic )
-	{
-		pareto_front = lexicographic( solve );
-	}
+		try
+		{
+			if ( !argument::trace_file.empty() )
+			{
+				trace.reset( new trace_writer( argument::trace_file ) );
+			}
 
-	// End benchmark
-	t_end = std::clock();
+			serve( argument::serve_address, trace.get() );
+		}
+		catch ( const std::exception & e )
+		{
+			std::cerr << "Error: " << e.what() << std::endl;
+		}
+		return 0;
+	}
 
-	// Filter
-	if ( argument::verbose )
+	// Batch mode: several instances in one process
+	if ( !argument::convert && ( !argument::batch_file.empty() || argument::filenames.size() > 1 ) )
 	{
-		std::clog << "Filtering..." << std::endl;
-	}
+		std::vector<batch_job> jobs;
+		std::auto_ptr<trace_writer> trace;
 
-	pareto_front.remove_if( predicate_is_dominated( pareto_front ) );
+		if ( !argument::checkpoint_file.empty() )
+		{
+			std::cerr << "Error: --checkpoint is not supported in batch mode" << std::endl;
+			return 0;
+		}
 
-	// Display
-	display( pareto_front, std::cout );
+		try
+		{
+			for ( std::size_t index = 0; index < argument::filenames.size(); ++index )
+			{
+				jobs.push_back( batch_job( argument::filenames[index], argument::method() ) );
+			}
 
-	if ( argument::verbose )
-	{
-		std::clog << "Elapsed time: "
-			<< ( t_end - t_start ) / (double)CLOCKS_PER_SEC
-			<< "s" << std::endl;
-	}
+			if ( !argument::batch_file.empty() )
+			{
+				read_manifest( argument::batch_file, argument::method(), jobs );
+			}
 
-	return 0;
-}
+			if ( !argument::trace_file.empty() )
+			{
+				trace.reset( new trace_writer( argument::trace_file ) );
+			}
+		}
+		catch ( const std::exception & e )
+		{
+			std::cerr << "Error: " << e.what() << std::endl;
+			return 0;
+		}
 
-////////////////////////////////////////////////////////////////////////////////
+		budget::catch_signals();
 
-std::list< std::vector<double> > lexicographic( flp_solver & solve )
-{
-	std::list< std::vector<double> > pareto_front;
-	std::vector<double> y( 2 );
+		// The points are only written with the results
+		argument::verbose = 0;
 
-	// One objective
-	if ( argument::objective )
-	{
-		solve.weighted_sum( argument::objective == 1 ? 0. : 1. );
-		y[0] = solve.z( 0 );
-		y[1] = solve.z( 1 );
-		pareto_front.push_back( y );
-		display_last( solve, pareto_front, std::clog );
+		run_batch( jobs, argument::jobs, trace.get(), std::cout );
+		return 0;
 	}
-	else // All objectives
+
+	// Parse the instance
+	if ( argument::verbose )
 	{
-		solve.weighted_sum( 0 );
-		y[0] = solve.z( 0 );
-		y[1] = solve.z( 1 );
-		pareto_front.push_back( y );
-		display_last( solve, pareto_front, std::clog );
-
-		solve.weighted_sum( 1 );
-		y[0] = solve.z( 0 );
-		y[1] = solve.z( 1 );
-		pareto_front.push_back( y );
-		display_last( solve, pareto_front, std::clog );
+		std::clog << "Parsing " << argument::filename << "..." << std::endl;
 	}
-	return pareto_front;
-}
 
-std::list< std::vector<double> > weighted_sum( flp_solver & solve )
-{
-	std::list< std::vector<double> > pareto_front;
-	std::vector<double> y( 2 );
+	problem instance( argument::objectives, (bool)argument::capacitated, (bool)argument::single_source );
+	mapped_file file;
+	std::auto_ptr<trace_writer> trace;
+	std::auto_ptr<checkpoint> state;
+	std::auto_ptr<front_writer> output;
+	std::auto_ptr<solution_store> solutions;
 
-	solve.weighted_sum( argument::lambda );
-	y[0] = solve.z( 0 );
-	y[1] = solve.z( 1 );
-	pareto_front.push_back( y );
-	display_last( solve, pareto_front, std::clog );
+	try
+	{
+		load_instance( argument::filename, file, instance );
 
-	return pareto_front;
-}
+		// Convert the instance
+		if ( argument::convert )
+		{
+			write_binary_instance( argument::destination, instance );
+			return 0;
+		}
 
-std::list< std::vector<double> > dichotomic_method( flp_solver & solve )
-{
-	std::list< std::vector<double> > pareto_front;
-	std::list< std::vector<double> >::const_iterator it;
-	std::queue< std::pair< std::vector<double>, std::vector<double> > > triangles;
-	std::vector<double> y1( 2 ), y2( 2 ), y( 2 );
-
-	// Find the lexicographically optimal solutions
-	solve.weighted_sum( 0 );
-	y1[0] = solve.z( 0 );
-	y1[1] = solve.z( 1 );
-	pareto_front.push_back( y1 );
-	display_last( solve, pareto_front, std::clog );
-
-	solve.weighted_sum( 1 );
-	y2[0] = solve.z( 0 );
-	y2[1] = solve.z( 1 );
-	pareto_front.push_back( y2 );
-	display_last( solve, pareto_front, std::clog );
-
-	// Add the first triangle
-	triangles.push( std::make_pair( y1, y2 ) );
-
-	// Solve all triangles
-	while ( !triangles.empty() )
-	{
-		y1 = triangles.front().first;
-		y2 = triangles.front().second;
-		triangles.pop();
+		// Open the trace
+		if ( !argument::trace_file.empty() )
+		{
+			trace.reset( new trace_writer( argument::trace_file ) );
+		}
 
-		// Define the current direction
-		double lambda = ( y2[0] - y1[0] ) / ( y1[1] - y2[1] + y2[0] - y1[0] );
+		// Check the output format before solving
+		if ( !argument::output_format.empty() )
+		{
+			front_writer::parse_format( argument::output_format );
+		}
 
-		if ( solve.weighted_sum( lambda ) )
+		// Open the checkpoint, a missing file meaning a new run
+		if ( !argument::checkpoint_file.empty() )
 		{
-			y[0] = solve.z( 0 );
-			y[1] = solve.z( 1 );
-			pareto_front.push_back( y );
+			state.reset( new checkpoint( argument::checkpoint_file,
+				checkpoint::instance_hash( instance ) + " " + argument::identity(),
+				argument::checkpoint_interval ) );
 
-			// New point ?
-			if ( y != y1 && y != y2 )
+			if ( argument::resume && state->load() && argument::verbose )
 			{
-				// Solve recursion
-				triangles.push( std::make_pair( y1, y ) );
-				triangles.push( std::make_pair( y, y2 ) );
-				display_last( solve, pareto_front, std::clog );
+				std::clog << "Resuming from " << argument::checkpoint_file << " ("
+					<< state->points().size() << " points, "
+					<< state->tasks().size() << " tasks)" << std::endl;
 			}
 		}
 	}
-
-	return pareto_front;
-}
-
-std::list< std::vector<double> > epsilon_constraint( flp_solver & solve )
-{
-	std::list< std::vector<double> > pareto_front;
-	std::vector<double> y( 2 );
-	int obj1 = argument::objective, obj2 = ( argument::objective == 0 ? 1 : 0 );
-
-	solve.set_main_objective( obj1 );
-
-	// Initialize epsilon (default: infinity)
-	double epsilon = argument::from;
-
-	while ( solve.epsilon_constraint( epsilon ) )
+	catch ( const std::exception & e )
 	{
-		// Retrieve solution
-		y[0] = solve.z( 0 );
-		y[1] = solve.z( 1 );
-		pareto_front.push_back( y );
-		display_last( solve, pareto_front, std::clog );
-
-		// Update the epsilon value
-		epsilon = y[obj2] - argument::step;
+		std::cerr << "Error: " << e.what() << std::endl;
+		return 0;
 	}
 
-	return pareto_front;
-}
+	// Stop the solves on SIGINT/SIGTERM and keep the front found so far
+	budget::catch_signals();
 
-void display_solution( const flp_solver & solve, std::ostream & os )
-{
-	os << "y =";
-	for ( int j = 0; j < solve.instance.num_facilities; ++j )
-	{
-		os << ' ' << solve.y_real( j );
-	}
-	os << std::endl;
+	// Begin benchmark
+	cpu_start = std::clock();
+	wall.restart();
+	budget limits( argument::time_limit, argument::node_limit );
+	lower_bound_set bounds;
+	candidate_pool candidates( instance.num_objectives );
 
-	for ( int i = 0; i < solve.instance.num_customers; ++i )
+	// Solve
+	if ( argument::verbose )
 	{
-		os << "x[" << i+1 << "] =";
-		for ( int j = 0; j < solve.instance.num_facilities; ++j )
-		{
-			os << ' ' << solve.x_real( i, j );
-		}
-		os << std::endl;
+		std::clog << "Solving..." << std::endl;
 	}
-}
 
-void display( const std::vector<double> & z, std::ostream & os )
-{
-	for ( std::size_t k = 0; k < z.size(); ++k )
+	// Initialize solver
+	flp_solver solve( instance, argument::relaxation, argument::lazy_opening );
+	solve.set_verblevel( argument::verblevel );
+	solve.set_warm_start( argument::warm_start );
+	solve.set_reoptimization( argument::reopt );
+	solve.set_dual_extraction( argument::relaxation );
+	solve.set_heuristic( argument::heuristic );
+	solve.set_trace( trace.get() );
+	solve.set_budget( &limits );
+	solve.set_lower_bound_set( &bounds );
+
+	if ( argument::harvest )
+		solve.set_candidate_pool( &candidates );
+
+	// Keep the solution of every point
+	if ( !argument::solutions_file.empty() || ( !argument::output_format.empty() && argument::display_solution ) )
 	{
-		if ( k > 0 )
-			os << ' ';
-		os << z[k];
+		solutions.reset( new solution_store( instance, instance.single_source && !argument::relaxation ) );
+		solve.set_solution_store( solutions.get() );
 	}
-}
-
-void display( const std::list< std::vector<double> > & pareto_front, std::ostream & os )
-{
-	std::list< std::vector<double> >::const_iterator it;
 
-	for ( it = pareto_front.begin(); it != pareto_front.end(); ++it )
+	// Stream the points as they are found
+	if ( !argument::output_format.empty() )
 	{
-		display( *it, os );
-		os << std::endl;
+		output.reset( new front_writer( std::cout, front_writer::parse_format( argument::output_format ),
+			instance, solutions.get() ) );
+		solve.set_observer( output.get() );
 	}
-}
 
-void display_last( const flp_solver & solve, const std::list< std::vector<double> > & pareto_front, std::ostream & os )
-{
 	if ( argument::verbose )
 	{
-		display( pareto_front.back(), os );
-		os << std::endl;
-
-		if ( argument::display_solution )
-			display_solution( solve, os );
+		std::clog << "Build time: " << solve.get_build_time() << "s" << std::endl;
 	}
-}
 
-bool predicate_is_dominated::operator () ( const std::vector<double> & z ) const
-{
-	std::list< std::vector<double> >::const_iterator it;
+	pareto_front = run_method( solve, argument::method(), state.get() );
+
+	// End benchmark
+	cpu_end = std::clock();
+	double wall_time = wall.elapsed();
 
-	for ( it = s.begin(); it != s.end(); ++it )
+	// Fill the gaps of a stopped front with the feasible points met
+	int approximate = 0;
+	if ( limits.exhausted() && argument::harvest )
+		approximate = candidates.merge( pareto_front );
+
+	// Display
+	if ( output.get() )
+		output->finish( pareto_front );
+	else
+		display( pareto_front, std::cout );
+
+	// Save the solutions of the front
+	if ( solutions.get() )
 	{
-		bool dominated( true );
+		solutions->retain( pareto_front );
 
-		if ( &z == &(*it) )
-			dominated = false;
+		if ( argument::verbose )
+		{
+			std::clog << "Solutions: " << solutions->size() << " (" << solutions->bytes() << " bytes)" << std::endl;
+		}
 
-		for ( std::size_t k = 0; dominated && k < z.size(); ++k )
+		if ( !argument::solutions_file.empty() )
 		{
-			if ( z[k] < it->at( k ) )
-				dominated = false;
+			try
+			{
+				solutions->write( argument::solutions_file );
+			}
+			catch ( const std::exception & e )
+			{
+				std::cerr << "Error: " << e.what() << std::endl;
+			}
 		}
+	}
+
+	// Quality of a stopped front, the lower bound set being bi-objective
+	double gap = 0., relative_gap = 0.;
 
-		if ( dominated )
-			return true;
+	if ( instance.num_objectives == 2 && limits.exhausted() )
+	{
+		gap = bounds.gap( pareto_front );
+		double area = gap + lower_bound_set::hypervolume( pareto_front );
+		relative_gap = ( area > 0. ? ( gap < area ? gap / area : 1. ) : 0. );
+	}
+
+	if ( limits.exhausted() )
+	{
+		std::cerr << "Incomplete front (" << limits.reason() << ")";
+		if ( instance.num_objectives == 2 && gap == std::numeric_limits<double>::infinity() )
+			std::cerr << ": hypervolume gap unbounded";
+		else if ( instance.num_objectives == 2 )
+			std::cerr << ": hypervolume gap " << gap << " (" << 100. * relative_gap << "%)";
+		if ( approximate > 0 )
+			std::cerr << ", " << approximate << " candidate points not proven efficient";
+		std::cerr << std::endl;
 	}
-	return false;
-}
 
+	if ( argument::verbose )
+	{
+		const solver_statistics & statistics = solve.statistics();
+
+		std::clog
+			<< "Elapsed time: " << wall_time << "s" << std::endl
+			<< "CPU time: " << ( cpu_end - cpu_start ) / (double)CLOCKS_PER_SEC << "s" << std::endl
+			<< "Solves: " << statistics.solves << std::endl
+			<< "Nodes: " << statistics.nodes << std::endl
+			<< "LP iterations: " << statistics.lp_iterations << std::endl;
+
+		if ( instance.num_objectives == 2 && gap == std::numeric_limits<double>::infinity() )
+			std::clog << "Hypervolume gap: unbounded" << std::endl;
+		else if ( instance.num_objectives == 2 )
+			std::clog << "Hypervolume gap: " << gap << " (" << 100. * relative_gap << "%)" << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,90 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "mapped_file.hpp"
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+mapped_file::mapped_file() :
+	_data( 0 ),
+	_size( 0 ),
+	_open( false )
+{
+}
+
+mapped_file::mapped_file( const std::string & filename ) :
+	_data( 0 ),
+	_size( 0 ),
+	_open( false )
+{
+	open( filename );
+}
+
+mapped_file::~mapped_file()
+{
+	close();
+}
+
+void mapped_file::open( const std::string & filename )
+{
+	struct stat info;
+	int fd;
+
+	close();
+
+	fd = ::open( filename.c_str(), O_RDONLY );
+	if ( fd < 0 )
+		throw std::runtime_error( "unable to open '" + filename + "'" );
+
+	if ( fstat( fd, &info ) != 0 )
+	{
+		::close( fd );
+		throw std::runtime_error( "unable to stat '" + filename + "'" );
+	}
+
+	_size = info.st_size;
+
+	// mmap does not accept empty mappings
+	if ( _size > 0 )
+	{
+		_data = mmap( 0, _size, PROT_READ, MAP_PRIVATE, fd, 0 );
+		if ( _data == MAP_FAILED )
+		{
+			_data = 0;
+			_size = 0;
+			::close( fd );
+			throw std::runtime_error( "unable to map '" + filename + "'" );
+		}
+
+		// The file is read once from the beginning to the end
+		madvise( _data, _size, MADV_SEQUENTIAL );
+	}
+
+	::close( fd );
+	_open = true;
+}
+
+void mapped_file::close()
+{
+	if ( _data )
+		munmap( _data, _size );
+
+	_data = 0;
+	_size = 0;
+	_open = false;
+}
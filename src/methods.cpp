@@ -0,0 +1,1186 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "methods.hpp"
+#include "argument.hpp"
+#include "thread.hpp"
+#include "lagrangian.hpp"
+#include <queue>
+#include <stdexcept>
+#include <sstream>
+#include <list>
+#include <utility>
+#include <algorithm>
+#include <limits>
+
+/*
+	Class: triangle
+
+	A triangle of the dichotomic method, defined by two consecutive
+	supported points, with the solution of the first one as a primal start.
+*/
+struct triangle
+{
+	std::vector<double> y1, y2;   // Points
+	std::vector<double> start;    // Solution of y1 (see flp_solver::solution)
+
+	triangle( const std::vector<double> & y1, const std::vector<double> & y2, const std::vector<double> & start ) :
+		y1( y1 ), y2( y2 ), start( start ) {}
+};
+
+/*
+	Class: box
+
+	A box lower <= z < upper of the box method, the main objective being
+	ignored.
+*/
+struct box
+{
+	std::vector<double> lower, upper;
+
+	box( const std::vector<double> & lower, const std::vector<double> & upper ) :
+		lower( lower ), upper( upper ) {}
+};
+
+/*
+	Class: dichotomic_context
+
+	State shared by the threads of the parallel dichotomic method.
+*/
+struct dichotomic_context
+{
+	const problem & instance;
+	const flp_solver & master;      // Settings of the solvers
+	checkpoint * state;             // Checkpoint, or 0
+	archive pareto_front;
+	std::queue<triangle> triangles;
+	std::list<triangle> running;    // Triangles being solved
+	int busy;                       // Number of triangles being solved
+	solver_statistics statistics;   // Statistics of the finished threads
+	std::string error;              // First exception thrown by a thread
+	mutex lock;                     // Protect the members above, except instance and master
+	condition changed;              // Notified when triangles, busy or error change
+
+	dichotomic_context( const flp_solver & master, checkpoint * state ) :
+		instance( master.instance ), master( master ), state( state ), busy( 0 ) {}
+};
+
+/*
+	Class: epsilon_context
+
+	State shared by the threads of the parallel epsilon-constraint method.
+*/
+struct epsilon_context
+{
+	const problem & instance;
+	const flp_solver & master;    // Settings of the solvers
+	checkpoint * state;           // Checkpoint, or 0
+	archive pareto_front;
+	std::vector< std::vector<double> > slabs;     // Slabs {epsilon, lower}
+	int next_slab;                                // Index of the next slab to sweep
+	std::list< std::vector<double> > running;     // Slabs being swept, with the current epsilon
+	solver_statistics statistics; // Statistics of the finished threads
+	std::string error;            // First exception thrown by a thread
+	mutex lock;                   // Protect the members above, except instance, master and state
+
+	epsilon_context( const flp_solver & master, checkpoint * state ) :
+		instance( master.instance ), master( master ), state( state ), next_slab( 0 ) {}
+};
+
+/*
+	Function: dichotomic_worker
+
+	Solve triangles of a dichotomic_context until none are left. An
+	exception stops all the threads and is kept in the context.
+
+	Parameters:
+		arg - A pointer to a dichotomic_context.
+*/
+void * dichotomic_worker( void * arg );
+
+/*
+	Function: epsilon_worker
+
+	Sweep slabs of an epsilon_context until none are left. An exception
+	stops all the threads and is kept in the context.
+
+	Parameters:
+		arg - A pointer to an epsilon_context.
+*/
+void * epsilon_worker( void * arg );
+
+/*
+	Function: skip_step
+
+	Tell the lower bound set of a solver, if any, that no nondominated point
+	lies strictly between two consecutive values of the epsilon-constraint
+	method. This is the assumption behind the step value.
+
+	Parameters:
+		solve - A flp_solver instance.
+		k - The main objective.
+		epsilon - The next epsilon value.
+		z - The value of the other objective at the last point.
+*/
+void skip_step( flp_solver & solve, int k, double epsilon, double z );
+
+/*
+	Function: augment
+
+	Enable the augmented epsilon-constraint if --augmented is set, the
+	weight being delta over the range of the other objectives.
+
+	Parameters:
+		solve - A flp_solver instance.
+		range - The sum of the ranges of the other objectives.
+*/
+void augment( flp_solver & solve, double range );
+
+/*
+	Function: prune_triangle
+
+	With --lagrangian, bound the weighted sum of a triangle by Lagrangian
+	relaxation and add the bound to the lower bound set of the solver.
+
+	Parameters:
+		solve - A flp_solver instance.
+		engine - The Lagrangian engine of the thread.
+		y1 - A point of the segment of the triangle.
+		lambda - The direction of the triangle.
+
+	Returns:
+		true if the bound proves that no point lies below the segment, so
+		that the weighted sum needs not be solved.
+*/
+bool prune_triangle( flp_solver & solve, lagrangian & engine, const std::vector<double> & y1, double lambda );
+
+/*
+	Function: split_boxes
+
+	Split the boxes containing points dominated by a new point z, so that
+	the region dominated by z is a union of boxes.
+
+	Parameters:
+		boxes - The boxes of the box method.
+		z - A new point.
+		k - The main objective.
+*/
+void split_boxes( std::vector<box> & boxes, const std::vector<double> & z, int k );
+
+/*
+	Function: remove_boxes
+
+	Remove the boxes contained in lower <= z <= upper.
+
+	Parameters:
+		boxes - The boxes of the box method.
+		lower - The lower corner.
+		upper - The upper corner.
+		k - The main objective.
+*/
+void remove_boxes( std::vector<box> & boxes, const std::vector<double> & lower, const std::vector<double> & upper, int k );
+
+/*
+	Function: stopped
+
+	Returns:
+		true if the last solve has been stopped or the budget of a solver is
+		exhausted, a failed solve being then no proof of infeasibility.
+*/
+bool stopped( const flp_solver & solve );
+
+/*
+	Function: save_state
+
+	Save a checkpoint, a failure being only reported.
+*/
+void save_state( checkpoint & state, const archive & pareto_front, const std::vector<double> & parameters,
+	const std::vector< std::vector<double> > & tasks );
+
+/*
+	Function: load_triangles
+
+	Read the triangles {y1, y2} of a checkpoint, without primal start.
+*/
+void load_triangles( const checkpoint & state, std::queue<triangle> & triangles );
+
+/*
+	Function: save_triangles
+
+	Save the pending and running triangles of the dichotomic method.
+*/
+void save_triangles( checkpoint & state, const archive & pareto_front, std::queue<triangle> triangles,
+	const std::list<triangle> & running );
+
+/*
+	Function: save_slabs
+
+	Save the pending and running slabs of the parallel epsilon-constraint
+	method. The lock of the context must be held.
+*/
+void save_slabs( epsilon_context & context );
+
+/*
+	Function: save_boxes
+
+	Save the boxes {lower, upper} of the box method.
+*/
+void save_boxes( checkpoint & state, const archive & pareto_front, const std::vector<double> & parameters,
+	const std::vector<box> & boxes );
+
+/*
+	Function: report_point
+
+	Store the solution of a new point and notify the observer of a solver,
+	then display the point in verbose mode.
+*/
+void report_point( const flp_solver & solve, const std::vector<double> & z );
+
+////////////////////////////////////////////////////////////////////////////////
+
+archive lexicographic( flp_solver & solve )
+{
+	archive pareto_front;
+	std::vector<double> y( 2 );
+
+	// One objective
+	if ( argument::objective )
+	{
+		if ( solve.weighted_sum( argument::objective == 1 ? 0. : 1. ) )
+		{
+			solve.z( y );
+			pareto_front.insert( y );
+			report_point( solve, y );
+		}
+	}
+	else // All objectives
+	{
+		if ( solve.weighted_sum( 0 ) )
+		{
+			solve.z( y );
+			pareto_front.insert( y );
+			report_point( solve, y );
+		}
+
+		if ( solve.weighted_sum( 1 ) )
+		{
+			solve.z( y );
+			pareto_front.insert( y );
+			report_point( solve, y );
+		}
+	}
+	return pareto_front;
+}
+
+archive weighted_sum( flp_solver & solve )
+{
+	archive pareto_front;
+	std::vector<double> y( 2 );
+
+	if ( solve.weighted_sum( argument::lambda ) )
+	{
+		solve.z( y );
+		pareto_front.insert( y );
+		report_point( solve, y );
+	}
+
+	return pareto_front;
+}
+
+archive dichotomic_method( flp_solver & solve, checkpoint * state )
+{
+	archive pareto_front;
+	std::queue<triangle> triangles;
+	std::vector<double> y1( 2 ), y2( 2 ), y( 2 ), start, sol;
+	lagrangian engine( solve.instance );
+
+	if ( state && state->resumed() )
+	{
+		pareto_front = state->points();
+		load_triangles( *state, triangles );
+	}
+	else
+	{
+		// Find the lexicographically optimal solutions
+		if ( !solve.weighted_sum( 0 ) )
+			return pareto_front;
+
+		solve.z( y1 );
+		solve.solution( start );
+		pareto_front.insert( y1 );
+		report_point( solve, y1 );
+
+		if ( !solve.weighted_sum( 1 ) )
+			return pareto_front;
+
+		solve.z( y2 );
+		pareto_front.insert( y2 );
+		report_point( solve, y2 );
+
+		// Add the first triangle
+		triangles.push( triangle( y1, y2, start ) );
+	}
+
+	// Solve all triangles
+	while ( !triangles.empty() )
+	{
+		y1 = triangles.front().y1;
+		y2 = triangles.front().y2;
+		start.swap( triangles.front().start );
+		triangles.pop();
+
+		// Define the current direction
+		double lambda = ( y2[0] - y1[0] ) / ( y1[1] - y2[1] + y2[0] - y1[0] );
+
+		if ( prune_triangle( solve, engine, y1, lambda ) )
+			continue;
+
+		// y1 is optimal on the segment, hence a feasible start and a cutoff
+		solve.set_start( start );
+
+		if ( solve.weighted_sum( lambda ) )
+		{
+			solve.z( y );
+			pareto_front.insert( y );
+
+			// New point ?
+			if ( y != y1 && y != y2 )
+			{
+				// Solve recursion
+				solve.solution( sol );
+				triangles.push( triangle( y1, y, start ) );
+				triangles.push( triangle( y, y2, sol ) );
+				report_point( solve, y );
+			}
+		}
+		else if ( stopped( solve ) )
+		{
+			// Keep the triangle for a resume
+			triangles.push( triangle( y1, y2, start ) );
+			break;
+		}
+
+		if ( state && state->due() )
+			save_triangles( *state, pareto_front, triangles, std::list<triangle>() );
+	}
+
+	if ( state )
+		save_triangles( *state, pareto_front, triangles, std::list<triangle>() );
+
+	return pareto_front;
+}
+
+archive parallel_dichotomic_method( flp_solver & solve, int num_threads, checkpoint * state )
+{
+	dichotomic_context context( solve, state );
+	std::vector<double> y1( 2 ), y2( 2 ), start;
+
+	if ( state && state->resumed() )
+	{
+		context.pareto_front = state->points();
+		load_triangles( *state, context.triangles );
+	}
+	else
+	{
+		// Find the lexicographically optimal solutions
+		if ( !solve.weighted_sum( 0 ) )
+			return context.pareto_front;
+
+		solve.z( y1 );
+		solve.solution( start );
+		context.pareto_front.insert( y1 );
+		report_point( solve, y1 );
+
+		if ( !solve.weighted_sum( 1 ) )
+			return context.pareto_front;
+
+		solve.z( y2 );
+		context.pareto_front.insert( y2 );
+		report_point( solve, y2 );
+
+		// Add the first triangle
+		context.triangles.push( triangle( y1, y2, start ) );
+	}
+
+	// Solve all triangles
+	run_threads( num_threads, dichotomic_worker, &context );
+	solve.merge_statistics( context.statistics );
+
+	// the triangle of a failed thread is still running, hence saved
+	if ( state )
+		save_triangles( *state, context.pareto_front, context.triangles, context.running );
+
+	if ( !context.error.empty() )
+		throw std::runtime_error( context.error );
+
+	return context.pareto_front;
+}
+
+void * dichotomic_worker( void * arg )
+{
+	dichotomic_context & context = *static_cast<dichotomic_context *>( arg );
+	std::vector<double> y1( 2 ), y2( 2 ), y( 2 ), start, sol;
+	bool locked = false;
+
+	try
+	{
+		// Each thread owns its own SCIP instance
+		flp_solver solve( context.instance, argument::relaxation, argument::lazy_opening );
+		solve.copy_settings( context.master );
+		lagrangian engine( context.instance );
+
+		context.lock.lock();
+		locked = true;
+
+		for ( ;; )
+		{
+			// Wait until a triangle is available or every thread is idle
+			while ( context.triangles.empty() && context.busy > 0 && context.error.empty() )
+				context.changed.wait( context.lock );
+
+			if ( context.triangles.empty() || stopped( solve ) || !context.error.empty() )
+				break;
+
+			std::list<triangle>::iterator current = context.running.insert( context.running.end(), context.triangles.front() );
+			context.triangles.pop();
+			++context.busy;
+
+			y1 = current->y1;
+			y2 = current->y2;
+			start = current->start;
+
+			context.lock.unlock();
+			locked = false;
+
+			// Define the current direction
+			double lambda = ( y2[0] - y1[0] ) / ( y1[1] - y2[1] + y2[0] - y1[0] );
+
+			bool pruned = prune_triangle( solve, engine, y1, lambda ), found = false;
+
+			// y1 is optimal on the segment, hence a feasible start and a cutoff
+			if ( !pruned )
+			{
+				solve.set_start( start );
+				found = solve.weighted_sum( lambda );
+			}
+
+			if ( found )
+			{
+				solve.z( y );
+				solve.solution( sol );
+			}
+
+			context.lock.lock();
+			locked = true;
+			--context.busy;
+
+			if ( found )
+			{
+				context.pareto_front.insert( y );
+
+				// New point ?
+				if ( y != y1 && y != y2 )
+				{
+					// Solve recursion
+					context.triangles.push( triangle( y1, y, start ) );
+					context.triangles.push( triangle( y, y2, sol ) );
+					report_point( solve, y );
+				}
+			}
+			else if ( !pruned && stopped( solve ) )
+			{
+				// Keep the triangle for a resume
+				context.triangles.push( *current );
+			}
+
+			context.running.erase( current );
+
+			if ( context.state && context.state->due() )
+				save_triangles( *context.state, context.pareto_front, context.triangles, context.running );
+
+			context.changed.notify_all();
+		}
+
+		context.statistics += solve.statistics();
+	}
+	catch ( const std::exception & e )
+	{
+		if ( !locked )
+			context.lock.lock();
+
+		// The other threads stop before their next triangle
+		if ( context.error.empty() )
+			context.error = e.what();
+	}
+
+	context.changed.notify_all();
+	context.lock.unlock();
+	return 0;
+}
+
+archive epsilon_constraint( flp_solver & solve, checkpoint * state )
+{
+	archive pareto_front;
+	std::vector<double> y( 2 ), parameters( 2 );
+	std::vector< std::vector<double> > tasks;
+	int obj1 = argument::objective, obj2 = ( argument::objective == 0 ? 1 : 0 );
+
+	solve.set_main_objective( obj1 );
+
+	// Initialize epsilon (default: infinity)
+	double epsilon = argument::from;
+	double ideal = -std::numeric_limits<double>::infinity();
+
+	if ( state && state->resumed() )
+	{
+		pareto_front = state->points();
+
+		if ( state->tasks().empty() )
+			return pareto_front;
+
+		epsilon = state->tasks()[0][0];
+		ideal = state->parameters()[0];
+		solve.set_augmentation( state->parameters()[1] );
+	}
+	else if ( argument::augmented > 0. )
+	{
+		// Payoff table: the sweep ends at the ideal value of the other
+		// objective instead of an infeasible solve
+		if ( !solve.weighted_sum( 1 ) )
+			return pareto_front;
+
+		ideal = solve.z( obj2 );
+
+		if ( !solve.weighted_sum( 0 ) )
+			return pareto_front;
+
+		augment( solve, std::min( epsilon, solve.z( obj2 ) ) - ideal );
+	}
+	else if ( argument::lagrangian > 0 )
+	{
+		// Levels below a Lagrangian bound of the other objective are
+		// infeasible, the last solve of the sweep is saved
+		lagrangian engine( solve.instance );
+		std::vector<double> weights( 2, 0. );
+
+		weights[obj2] = 1.;
+		ideal = engine.bound( weights, std::numeric_limits<double>::infinity(), argument::lagrangian );
+		ideal -= lagrangian::tolerance();
+	}
+
+	parameters[0] = ideal;
+	parameters[1] = solve.get_augmentation();
+
+	while ( epsilon >= ideal && solve.epsilon_constraint( epsilon ) )
+	{
+		// Retrieve solution
+		solve.z( y );
+		pareto_front.insert( y );
+		report_point( solve, y );
+
+		// Update the epsilon value
+		epsilon = y[obj2] - argument::step;
+		skip_step( solve, obj1, epsilon, y[obj2] );
+
+		if ( state && state->due() )
+			save_state( *state, pareto_front, parameters, std::vector< std::vector<double> >( 1, std::vector<double>( 1, epsilon ) ) );
+	}
+
+	if ( state )
+	{
+		// epsilon is left if the sweep has been stopped by the budget
+		if ( epsilon >= ideal && stopped( solve ) )
+			tasks.push_back( std::vector<double>( 1, epsilon ) );
+
+		save_state( *state, pareto_front, parameters, tasks );
+	}
+
+	return pareto_front;
+}
+
+archive parallel_epsilon_constraint( flp_solver & solve, int num_threads, int num_slabs, checkpoint * state )
+{
+	epsilon_context context( solve, state );
+	std::vector<double> y1( 2 ), y2( 2 ), slab( 2 );
+	int obj1 = argument::objective, obj2 = ( argument::objective == 0 ? 1 : 0 );
+
+	solve.set_main_objective( obj1 );
+
+	if ( state && state->resumed() )
+	{
+		context.pareto_front = state->points();
+		context.slabs = state->tasks();
+		solve.set_augmentation( state->parameters()[0] );
+	}
+	else
+	{
+		// First endpoint: best value of the main objective
+		if ( !solve.epsilon_constraint( argument::from ) )
+			return context.pareto_front;
+
+		solve.z( y1 );
+		context.pareto_front.insert( y1 );
+		report_point( solve, y1 );
+
+		// Second endpoint: best value of the other objective, then best value
+		// of the main objective at this level
+		if ( !solve.weighted_sum( 1 ) )
+			return context.pareto_front;
+
+		double ideal = solve.z( obj2 );
+
+		solve.set_main_objective( obj1 );
+		augment( solve, y1[obj2] - ideal );
+
+		if ( !solve.epsilon_constraint( ideal ) )
+			return context.pareto_front;
+
+		solve.z( y2 );
+		context.pareto_front.insert( y2 );
+		report_point( solve, y2 );
+
+		// Split the remaining range of the other objective into slabs
+		double upper = y1[obj2] - argument::step;
+		skip_step( solve, obj1, upper, y1[obj2] );
+
+		if ( num_slabs < 1 )
+			num_slabs = num_threads;
+
+		for ( int s = 0; upper >= ideal && s < num_slabs; ++s )
+		{
+			slab[0] = upper - s * ( upper - ideal ) / num_slabs;
+			slab[1] = ( s + 1 < num_slabs ? upper - ( s + 1 ) * ( upper - ideal ) / num_slabs : ideal );
+			context.slabs.push_back( slab );
+		}
+	}
+
+	// Sweep all slabs
+	if ( !context.slabs.empty() )
+	{
+		run_threads( std::min( num_threads, (int)context.slabs.size() ), epsilon_worker, &context );
+		solve.merge_statistics( context.statistics );
+	}
+
+	// the slab of a failed thread is still running, hence saved
+	if ( state )
+		save_slabs( context );
+
+	if ( !context.error.empty() )
+		throw std::runtime_error( context.error );
+
+	return context.pareto_front;
+}
+
+void * epsilon_worker( void * arg )
+{
+	epsilon_context & context = *static_cast<epsilon_context *>( arg );
+	std::vector<double> y( 2 );
+	int obj1 = argument::objective, obj2 = ( argument::objective == 0 ? 1 : 0 );
+
+	try
+	{
+		// Each thread owns its own SCIP instance
+		flp_solver solve( context.instance, argument::relaxation, argument::lazy_opening );
+		solve.copy_settings( context.master );
+		solve.set_main_objective( obj1 );
+
+		for ( ;; )
+		{
+			std::list< std::vector<double> >::iterator current;
+
+			{
+				lock_guard guard( context.lock );
+				if ( context.next_slab >= (int)context.slabs.size() || stopped( solve ) || !context.error.empty() )
+					break;
+				current = context.running.insert( context.running.end(), context.slabs[context.next_slab++] );
+			}
+
+			double epsilon = (*current)[0], lower = (*current)[1];
+
+			// Stop as soon as epsilon leaves the slab
+			while ( epsilon >= lower && solve.epsilon_constraint( epsilon, lower ) )
+			{
+				// Retrieve solution
+				solve.z( y );
+
+				// Update the epsilon value
+				epsilon = y[obj2] - argument::step;
+				skip_step( solve, obj1, epsilon, y[obj2] );
+
+				lock_guard guard( context.lock );
+				context.pareto_front.insert( y );
+				report_point( solve, y );
+				(*current)[0] = epsilon;
+
+				if ( context.state && context.state->due() )
+					save_slabs( context );
+			}
+
+			lock_guard guard( context.lock );
+
+			// Keep the rest of the slab for a resume, no slab is taken afterwards
+			if ( epsilon >= lower && stopped( solve ) )
+				context.slabs.push_back( *current );
+
+			context.running.erase( current );
+		}
+
+		lock_guard guard( context.lock );
+		context.statistics += solve.statistics();
+	}
+	catch ( const std::exception & e )
+	{
+		lock_guard guard( context.lock );
+
+		// The other threads stop before their next slab
+		if ( context.error.empty() )
+			context.error = e.what();
+	}
+
+	return 0;
+}
+
+void skip_step( flp_solver & solve, int k, double epsilon, double z )
+{
+	lower_bound_set * bounds = solve.get_lower_bound_set();
+
+	if ( bounds )
+		bounds->add_epsilon_constraint( k, epsilon, z, std::numeric_limits<double>::infinity() );
+}
+
+void augment( flp_solver & solve, double range )
+{
+	if ( argument::augmented > 0. )
+		solve.set_augmentation( argument::augmented / std::max( range, 1. ) );
+}
+
+bool stopped( const flp_solver & solve )
+{
+	return solve.interrupted() || ( solve.get_budget() && solve.get_budget()->exhausted() );
+}
+
+void save_state( checkpoint & state, const archive & pareto_front, const std::vector<double> & parameters,
+	const std::vector< std::vector<double> > & tasks )
+{
+	// a failed checkpoint must not stop the run
+	try
+	{
+		state.save( pareto_front, parameters, tasks );
+	}
+	catch ( const std::exception & e )
+	{
+		std::cerr << "Warning: " << e.what() << std::endl;
+	}
+}
+
+void load_triangles( const checkpoint & state, std::queue<triangle> & triangles )
+{
+	std::vector<double> y1( 2 ), y2( 2 );
+
+	for ( std::size_t t = 0; t < state.tasks().size(); ++t )
+	{
+		const std::vector<double> & task = state.tasks()[t];
+
+		y1[0] = task[0];
+		y1[1] = task[1];
+		y2[0] = task[2];
+		y2[1] = task[3];
+		triangles.push( triangle( y1, y2, std::vector<double>() ) );
+	}
+}
+
+void save_triangles( checkpoint & state, const archive & pareto_front, std::queue<triangle> triangles,
+	const std::list<triangle> & running )
+{
+	std::vector< std::vector<double> > tasks;
+	std::vector<double> task( 4 );
+
+	for ( ; !triangles.empty(); triangles.pop() )
+	{
+		task[0] = triangles.front().y1[0];
+		task[1] = triangles.front().y1[1];
+		task[2] = triangles.front().y2[0];
+		task[3] = triangles.front().y2[1];
+		tasks.push_back( task );
+	}
+
+	for ( std::list<triangle>::const_iterator it = running.begin(); it != running.end(); ++it )
+	{
+		task[0] = it->y1[0];
+		task[1] = it->y1[1];
+		task[2] = it->y2[0];
+		task[3] = it->y2[1];
+		tasks.push_back( task );
+	}
+
+	save_state( state, pareto_front, std::vector<double>(), tasks );
+}
+
+void save_slabs( epsilon_context & context )
+{
+	std::vector< std::vector<double> > tasks( context.slabs.begin() + context.next_slab, context.slabs.end() );
+
+	tasks.insert( tasks.end(), context.running.begin(), context.running.end() );
+
+	save_state( *context.state, context.pareto_front,
+		std::vector<double>( 1, context.master.get_augmentation() ), tasks );
+}
+
+archive box_method( flp_solver & solve, checkpoint * state )
+{
+	int p = solve.instance.num_objectives, k = argument::objective;
+	archive pareto_front( p );
+	std::vector<box> boxes;
+	std::vector<double> y( p ), ideal( p ), nadir( p ), epsilon( p ), parameters;
+	const double inf = std::numeric_limits<double>::infinity();
+
+	if ( state && state->resumed() )
+	{
+		pareto_front = state->points();
+
+		// parameters: augmentation, ideal point, nadir estimate
+		const std::vector<double> & saved = state->parameters();
+		ideal.assign( saved.begin() + 1, saved.begin() + 1 + p );
+		nadir.assign( saved.begin() + 1 + p, saved.end() );
+
+		solve.set_main_objective( k );
+		solve.set_augmentation( saved[0] );
+
+		// tasks: lower and upper corners
+		for ( std::size_t t = 0; t < state->tasks().size(); ++t )
+		{
+			const std::vector<double> & task = state->tasks()[t];
+			boxes.push_back( box( std::vector<double>( task.begin(), task.begin() + p ),
+				std::vector<double>( task.begin() + p, task.end() ) ) );
+		}
+	}
+	else
+	{
+		// Payoff table: ideal point and an estimate of the nadir point
+		ideal.assign( p, inf );
+		nadir.assign( p, -inf );
+
+		for ( int l = 0; l < p; ++l )
+		{
+			solve.set_main_objective( l );
+
+			if ( !solve.epsilon_constraint( std::vector<double>( p, inf ) ) )
+				return pareto_front;
+
+			// Not inserted, since the point can be weakly efficient
+			solve.z( y );
+
+			for ( int m = 0; m < p; ++m )
+			{
+				ideal[m] = std::min( ideal[m], y[m] );
+				nadir[m] = std::max( nadir[m], y[m] );
+			}
+		}
+
+		// Weakly efficient points would be found again and again
+		double range = 0.;
+		for ( int l = 0; l < p; ++l )
+		{
+			if ( l != k )
+				range += nadir[l] - ideal[l];
+		}
+
+		solve.set_main_objective( k );
+		solve.set_augmentation( ( argument::augmented > 0. ? argument::augmented : 1e-3 ) / std::max( range, 1. ) );
+
+		// The nondominated points lie in ideal <= z < infinity, the main
+		// objective being ignored
+		boxes.push_back( box( ideal, std::vector<double>( p, inf ) ) );
+	}
+
+	parameters.push_back( solve.get_augmentation() );
+	parameters.insert( parameters.end(), ideal.begin(), ideal.end() );
+	parameters.insert( parameters.end(), nadir.begin(), nadir.end() );
+
+	while ( !boxes.empty() )
+	{
+		// Largest box, the infinite sides being cut at the nadir estimate
+		std::size_t selected = 0;
+		double largest = -1.;
+
+		for ( std::size_t b = 0; b < boxes.size(); ++b )
+		{
+			double volume = 1.;
+			for ( int l = 0; l < p; ++l )
+			{
+				if ( l != k )
+					volume *= std::min( boxes[b].upper[l], nadir[l] + argument::step ) - boxes[b].lower[l];
+			}
+
+			if ( volume > largest )
+			{
+				largest = volume;
+				selected = b;
+			}
+		}
+
+		std::vector<double> upper( boxes[selected].upper );
+
+		// Look for a point strictly below the upper corner
+		for ( int l = 0; l < p; ++l )
+		{
+			epsilon[l] = upper[l] - argument::step;
+		}
+
+		if ( solve.epsilon_constraint( epsilon ) )
+		{
+			solve.z( y );
+
+			if ( pareto_front.insert( y ) )
+			{
+				report_point( solve, y );
+				split_boxes( boxes, y, k );
+			}
+
+			// The points between y and upper are dominated by y
+			remove_boxes( boxes, y, upper, k );
+		}
+		else if ( stopped( solve ) )
+		{
+			break;
+		}
+		else
+		{
+			// No point below upper: the boxes below upper are empty
+			remove_boxes( boxes, ideal, upper, k );
+		}
+
+		if ( state && state->due() )
+			save_boxes( *state, pareto_front, parameters, boxes );
+	}
+
+	if ( state )
+		save_boxes( *state, pareto_front, parameters, boxes );
+
+	return pareto_front;
+}
+
+void split_boxes( std::vector<box> & boxes, const std::vector<double> & z, int k )
+{
+	std::vector<box> result;
+	int p = (int)z.size();
+
+	result.reserve( boxes.size() );
+
+	for ( std::size_t b = 0; b < boxes.size(); ++b )
+	{
+		box rest( boxes[b] );
+		bool inside = true;
+
+		for ( int l = 0; l < p; ++l )
+		{
+			if ( l != k && z[l] >= rest.upper[l] )
+				inside = false;
+		}
+
+		// Split along each objective, keeping the part below z, until the
+		// remaining part is above z in every objective
+		for ( int l = 0; inside && l < p; ++l )
+		{
+			if ( l == k || z[l] <= rest.lower[l] )
+				continue;
+
+			box below( rest );
+			below.upper[l] = z[l];
+			result.push_back( below );
+
+			rest.lower[l] = z[l];
+		}
+
+		result.push_back( rest );
+	}
+
+	boxes.swap( result );
+}
+
+void remove_boxes( std::vector<box> & boxes, const std::vector<double> & lower, const std::vector<double> & upper, int k )
+{
+	std::vector<box> result;
+	int p = (int)lower.size();
+
+	result.reserve( boxes.size() );
+
+	for ( std::size_t b = 0; b < boxes.size(); ++b )
+	{
+		bool contained = true;
+
+		for ( int l = 0; l < p; ++l )
+		{
+			if ( l != k && ( boxes[b].lower[l] < lower[l] || boxes[b].upper[l] > upper[l] ) )
+				contained = false;
+		}
+
+		if ( !contained )
+			result.push_back( boxes[b] );
+	}
+
+	boxes.swap( result );
+}
+
+void save_boxes( checkpoint & state, const archive & pareto_front, const std::vector<double> & parameters,
+	const std::vector<box> & boxes )
+{
+	std::vector< std::vector<double> > tasks( boxes.size() );
+
+	for ( std::size_t b = 0; b < boxes.size(); ++b )
+	{
+		tasks[b] = boxes[b].lower;
+		tasks[b].insert( tasks[b].end(), boxes[b].upper.begin(), boxes[b].upper.end() );
+	}
+
+	save_state( state, pareto_front, parameters, tasks );
+}
+
+archive run_method( flp_solver & solve, const std::string & method, checkpoint * state )
+{
+	if ( solve.instance.num_objectives > 2 )
+	{
+		if ( method != "efficient" )
+			throw std::runtime_error( "only efficient supports more than two objectives" );
+		return box_method( solve, state );
+	}
+
+	if ( method == "efficient" )
+	{
+		if ( argument::threads > 1 )
+			return parallel_epsilon_constraint( solve, argument::threads, argument::slabs, state );
+		return epsilon_constraint( solve, state );
+	}
+
+	if ( method == "supported" )
+	{
+		if ( argument::threads > 1 )
+			return parallel_dichotomic_method( solve, argument::threads, state );
+		return dichotomic_method( solve, state );
+	}
+
+	if ( method == "weighted-sum" )
+		return weighted_sum( solve );
+
+	return lexicographic( solve );
+}
+
+bool prune_triangle( flp_solver & solve, lagrangian & engine, const std::vector<double> & y1, double lambda )
+{
+	if ( argument::lagrangian <= 0 )
+		return false;
+
+	int k = solve.get_main_objective(), l = ( k == 0 ? 1 : 0 );
+	std::vector<double> weights( 2 );
+
+	weights[k] = 1. - lambda;
+	weights[l] = lambda;
+
+	// the duals of the last linear relaxation are close to optimal multipliers
+	if ( solve.get_dual_extraction() && solve.statistics().solves > 0 )
+	{
+		std::vector<double> u( solve.instance.num_customers );
+		for ( int i = 0; i < solve.instance.num_customers; ++i )
+		{
+			u[i] = solve.assignment_dual( i );
+		}
+		engine.set_multipliers( u );
+	}
+
+	// the segment is the value of the weighted sum at y1 and y2
+	double segment = weights[0] * y1[0] + weights[1] * y1[1];
+	double bound = engine.bound( weights, segment, argument::lagrangian );
+
+	if ( solve.get_lower_bound_set() )
+		solve.get_lower_bound_set()->add_weighted_sum( k, lambda, bound );
+
+	return bound >= segment - lagrangian::tolerance();
+}
+
+void report_point( const flp_solver & solve, const std::vector<double> & z )
+{
+	if ( solve.get_solution_store() )
+		solve.get_solution_store()->insert( solve, z );
+
+	if ( solve.get_observer() )
+		solve.get_observer()->found( solve, z );
+
+	display_last( solve, z, std::clog );
+}
+
+void display_solution( const flp_solver & solve, std::ostream & os )
+{
+	// Formatted first, std::clog writing every insertion at once
+	std::ostringstream buffer;
+
+	buffer << "y =";
+	for ( int j = 0; j < solve.instance.num_facilities; ++j )
+	{
+		buffer << ' ' << solve.y_real( j );
+	}
+	buffer << '\n';
+
+	for ( int i = 0; i < solve.instance.num_customers; ++i )
+	{
+		buffer << "x[" << i+1 << "] =";
+		for ( int j = 0; j < solve.instance.num_facilities; ++j )
+		{
+			buffer << ' ' << solve.x_real( i, j );
+		}
+		buffer << '\n';
+	}
+
+	os << buffer.str() << std::flush;
+}
+
+void display( const std::vector<double> & z, std::ostream & os )
+{
+	for ( std::size_t k = 0; k < z.size(); ++k )
+	{
+		if ( k > 0 )
+			os << ' ';
+		os << z[k];
+	}
+}
+
+void display( const archive & pareto_front, std::ostream & os )
+{
+	for ( int index = 0; index < pareto_front.size(); ++index )
+	{
+		for ( int k = 0; k < pareto_front.dimension(); ++k )
+		{
+			if ( k > 0 )
+				os << ' ';
+			os << pareto_front[index][k];
+		}
+		os << '\n';
+	}
+}
+
+void display_last( const flp_solver & solve, const std::vector<double> & z, std::ostream & os )
+{
+	if ( argument::verbose )
+	{
+		std::ostringstream buffer;
+
+		display( z, buffer );
+		buffer << '\n';
+		os << buffer.str() << std::flush;
+
+		if ( argument::display_solution )
+			display_solution( solve, os );
+	}
+}
+
@@ -0,0 +1,285 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "opening_conshdlr.hpp"
+#include <vector>
+#include <cmath>
+
+#define CONSHDLR_NAME          "flpopening"
+#define CONSHDLR_DESC          "facility opening constraints x(i,j) <= y(j)"
+#define CONSHDLR_ENFOPRIORITY  -1100000   // after the linear constraints
+#define CONSHDLR_CHECKPRIORITY -1100000
+#define CONSHDLR_EAGERFREQ     100
+#define CONSHDLR_NEEDSCONS     TRUE
+#define CONSHDLR_SEPAPRIORITY  0
+#define CONSHDLR_SEPAFREQ      1
+#define CONSHDLR_DELAYSEPA     FALSE
+
+// Data of a constraint, the variables are not captured
+struct SCIP_ConsData
+{
+	int num_customers, num_facilities;
+	std::vector<SCIP_VAR *> x;   // x(i,j) = x[i*n+j]
+	std::vector<SCIP_VAR *> y;
+};
+
+/*
+	Function: separate
+
+	Add a cut x(i,j) <= y(j) for every violated pair of a solution.
+
+	Parameters:
+		scip - A SCIP instance.
+		conshdlr - The constraint handler.
+		consdata - The data of the constraint.
+		sol - A solution, 0 for the LP solution.
+		force - Add the cuts even if they are not efficacious.
+		result - SCIP_SEPARATED, SCIP_CUTOFF or left unchanged.
+*/
+static SCIP_RETCODE separate( SCIP * scip, SCIP_CONSHDLR * conshdlr, SCIP_CONSDATA * consdata,
+	SCIP_SOL * sol, SCIP_Bool force, SCIP_RESULT * result )
+{
+	int n = consdata->num_facilities;
+	std::vector<SCIP_Real> y( n );
+
+	SCIP_CALL( SCIPgetSolVals( scip, sol, n, &consdata->y[0], &y[0] ) );
+
+	for ( int i = 0; i < consdata->num_customers; ++i )
+	{
+		for ( int j = 0; j < n; ++j )
+		{
+			SCIP_VAR * x = consdata->x[i*n + j];
+			SCIP_Real violation = SCIPgetSolVal( scip, sol, x ) - y[j];
+
+			// the norm of the row is sqrt(2)
+			if ( !SCIPisFeasGT( scip, violation, 0. ) )
+				continue;
+			if ( !force && !SCIPisEfficacious( scip, violation / std::sqrt( 2. ) ) )
+				continue;
+
+			SCIP_ROW * row;
+			SCIP_Bool infeasible;
+
+			// x(i,j) - y(j) <= 0, globally valid and removable
+			SCIP_CALL( SCIPcreateEmptyRowCons( scip, &row, conshdlr, "open", -SCIPinfinity( scip ), 0.,
+				FALSE, FALSE, TRUE ) );
+			SCIP_CALL( SCIPcacheRowExtensions( scip, row ) );
+			SCIP_CALL( SCIPaddVarToRow( scip, row, x, 1. ) );
+			SCIP_CALL( SCIPaddVarToRow( scip, row, consdata->y[j], -1. ) );
+			SCIP_CALL( SCIPflushRowExtensions( scip, row ) );
+
+			SCIP_CALL( SCIPaddCut( scip, sol, row, force, &infeasible ) );
+			SCIP_CALL( SCIPreleaseRow( scip, &row ) );
+
+			if ( infeasible )
+			{
+				*result = SCIP_CUTOFF;
+				return SCIP_OKAY;
+			}
+
+			*result = SCIP_SEPARATED;
+		}
+	}
+
+	return SCIP_OKAY;
+}
+
+/*
+	Function: is_violated
+
+	Parameters:
+		scip - A SCIP instance.
+		consdata - The data of the constraint.
+		sol - A solution, 0 for the current LP or pseudo solution.
+
+	Returns:
+		true if the solution violates x(i,j) <= y(j) for some pair.
+*/
+static bool is_violated( SCIP * scip, SCIP_CONSDATA * consdata, SCIP_SOL * sol )
+{
+	int n = consdata->num_facilities;
+
+	for ( int j = 0; j < n; ++j )
+	{
+		SCIP_Real y = SCIPgetSolVal( scip, sol, consdata->y[j] );
+
+		for ( int i = 0; i < consdata->num_customers; ++i )
+		{
+			if ( SCIPisFeasGT( scip, SCIPgetSolVal( scip, sol, consdata->x[i*n + j] ), y ) )
+				return true;
+		}
+	}
+	return false;
+}
+
+static SCIP_DECL_CONSCHECK(consCheckOpening)
+{
+	*result = SCIP_FEASIBLE;
+
+	for ( int c = 0; c < nconss; ++c )
+	{
+		if ( is_violated( scip, SCIPconsGetData( conss[c] ), sol ) )
+		{
+			*result = SCIP_INFEASIBLE;
+			return SCIP_OKAY;
+		}
+	}
+	return SCIP_OKAY;
+}
+
+static SCIP_DECL_CONSENFOLP(consEnfolpOpening)
+{
+	*result = SCIP_FEASIBLE;
+
+	// the LP solution is cut off, even by weak cuts
+	for ( int c = 0; c < nconss && *result != SCIP_CUTOFF; ++c )
+	{
+		SCIP_CALL( separate( scip, conshdlr, SCIPconsGetData( conss[c] ), 0, TRUE, result ) );
+	}
+	return SCIP_OKAY;
+}
+
+static SCIP_DECL_CONSENFOPS(consEnfopsOpening)
+{
+	*result = SCIP_FEASIBLE;
+
+	for ( int c = 0; c < nconss; ++c )
+	{
+		SCIP_CONSDATA * consdata = SCIPconsGetData( conss[c] );
+		int n = consdata->num_facilities;
+
+		for ( int i = 0; i < consdata->num_customers; ++i )
+		{
+			for ( int j = 0; j < n; ++j )
+			{
+				SCIP_VAR * x = consdata->x[i*n + j], * y = consdata->y[j];
+
+				if ( !SCIPisFeasGT( scip, SCIPgetSolVal( scip, 0, x ), SCIPgetSolVal( scip, 0, y ) ) )
+					continue;
+
+				// no branching can repair the pair if the bounds already violate it
+				if ( SCIPisFeasGT( scip, SCIPvarGetLbLocal( x ), SCIPvarGetUbLocal( y ) ) )
+				{
+					*result = SCIP_CUTOFF;
+					return SCIP_OKAY;
+				}
+
+				*result = SCIP_INFEASIBLE;
+			}
+		}
+	}
+	return SCIP_OKAY;
+}
+
+static SCIP_DECL_CONSLOCK(consLockOpening)
+{
+	SCIP_CONSDATA * consdata = SCIPconsGetData( cons );
+
+	// rounding x(i,j) up or y(j) down may violate the constraint
+	for ( std::size_t index = 0; index < consdata->x.size(); ++index )
+	{
+		SCIP_CALL( SCIPaddVarLocks( scip, consdata->x[index], nlocksneg, nlockspos ) );
+	}
+	for ( std::size_t index = 0; index < consdata->y.size(); ++index )
+	{
+		SCIP_CALL( SCIPaddVarLocks( scip, consdata->y[index], nlockspos, nlocksneg ) );
+	}
+	return SCIP_OKAY;
+}
+
+static SCIP_DECL_CONSSEPALP(consSepalpOpening)
+{
+	*result = SCIP_DIDNOTFIND;
+
+	for ( int c = 0; c < nusefulconss && *result != SCIP_CUTOFF; ++c )
+	{
+		SCIP_CALL( separate( scip, conshdlr, SCIPconsGetData( conss[c] ), 0, FALSE, result ) );
+	}
+	return SCIP_OKAY;
+}
+
+static SCIP_DECL_CONSSEPASOL(consSepasolOpening)
+{
+	*result = SCIP_DIDNOTFIND;
+
+	for ( int c = 0; c < nusefulconss && *result != SCIP_CUTOFF; ++c )
+	{
+		SCIP_CALL( separate( scip, conshdlr, SCIPconsGetData( conss[c] ), sol, FALSE, result ) );
+	}
+	return SCIP_OKAY;
+}
+
+static SCIP_DECL_CONSTRANS(consTransOpening)
+{
+	SCIP_CONSDATA * sourcedata = SCIPconsGetData( sourcecons );
+	SCIP_CONSDATA * targetdata = new SCIP_CONSDATA( *sourcedata );
+
+	SCIP_CALL( SCIPgetTransformedVars( scip, (int)targetdata->x.size(), &sourcedata->x[0], &targetdata->x[0] ) );
+	SCIP_CALL( SCIPgetTransformedVars( scip, (int)targetdata->y.size(), &sourcedata->y[0], &targetdata->y[0] ) );
+
+	SCIP_CALL( SCIPcreateCons( scip, targetcons, SCIPconsGetName( sourcecons ), conshdlr, targetdata,
+		SCIPconsIsInitial( sourcecons ), SCIPconsIsSeparated( sourcecons ),
+		SCIPconsIsEnforced( sourcecons ), SCIPconsIsChecked( sourcecons ),
+		SCIPconsIsPropagated( sourcecons ), SCIPconsIsLocal( sourcecons ),
+		SCIPconsIsModifiable( sourcecons ), SCIPconsIsDynamic( sourcecons ),
+		SCIPconsIsRemovable( sourcecons ), SCIPconsIsStickingAtNode( sourcecons ) ) );
+
+	return SCIP_OKAY;
+}
+
+static SCIP_DECL_CONSDELETE(consDeleteOpening)
+{
+	delete *consdata;
+	*consdata = 0;
+	return SCIP_OKAY;
+}
+
+SCIP_RETCODE include_opening_conshdlr( SCIP * scip )
+{
+	SCIP_CONSHDLR * conshdlr;
+
+	SCIP_CALL( SCIPincludeConshdlrBasic( scip, &conshdlr, CONSHDLR_NAME, CONSHDLR_DESC,
+		CONSHDLR_ENFOPRIORITY, CONSHDLR_CHECKPRIORITY, CONSHDLR_EAGERFREQ, CONSHDLR_NEEDSCONS,
+		consEnfolpOpening, consEnfopsOpening, consCheckOpening, consLockOpening, 0 ) );
+
+	SCIP_CALL( SCIPsetConshdlrSepa( scip, conshdlr, consSepalpOpening, consSepasolOpening,
+		CONSHDLR_SEPAFREQ, CONSHDLR_SEPAPRIORITY, CONSHDLR_DELAYSEPA ) );
+	SCIP_CALL( SCIPsetConshdlrTrans( scip, conshdlr, consTransOpening ) );
+	SCIP_CALL( SCIPsetConshdlrDelete( scip, conshdlr, consDeleteOpening ) );
+
+	return SCIP_OKAY;
+}
+
+SCIP_RETCODE create_opening_cons( SCIP * scip, SCIP_CONS ** cons, const char * name,
+	int num_customers, int num_facilities, SCIP_VAR ** x, SCIP_VAR ** y )
+{
+	SCIP_CONSHDLR * conshdlr = SCIPfindConshdlr( scip, CONSHDLR_NAME );
+	SCIP_CONSDATA * consdata;
+
+	if ( !conshdlr )
+		return SCIP_PLUGINNOTFOUND;
+
+	consdata = new SCIP_CONSDATA;
+	consdata->num_customers = num_customers;
+	consdata->num_facilities = num_facilities;
+	consdata->x.assign( x, x + num_customers * num_facilities );
+	consdata->y.assign( y, y + num_facilities );
+
+	// not initial: the LP starts from the aggregated rows only
+	SCIP_CALL( SCIPcreateCons( scip, cons, name, conshdlr, consdata,
+		FALSE, TRUE, TRUE, TRUE, FALSE, FALSE, FALSE, FALSE, FALSE, FALSE ) );
+
+	return SCIP_OKAY;
+}
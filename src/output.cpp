@@ -0,0 +1,285 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "output.hpp"
+#include <stdexcept>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+
+front_writer::format front_writer::parse_format( const std::string & name )
+{
+	if ( name == "ndjson" )
+		return ndjson;
+	if ( name == "csv" )
+		return csv;
+	if ( name == "bin" )
+		return bin;
+
+	throw std::runtime_error( "unknown output format '" + name + "'" );
+}
+
+front_writer::front_writer( std::ostream & os, format type, const problem & instance,
+	const solution_store * solutions ) :
+	_os( os ),
+	_format( type ),
+	_instance( instance ),
+	_solutions( solutions ),
+	_buffer(),
+	_lock()
+{
+	lock_guard guard( _lock );
+
+	if ( _format == csv )
+	{
+		_buffer += "type";
+		for ( int k = 0; k < _instance.num_objectives; ++k )
+		{
+			_buffer += ",z";
+			integer( k+1 );
+		}
+		if ( _solutions )
+			_buffer += ",open,assign";
+		_buffer += '\n';
+	}
+	else if ( _format == bin )
+	{
+		output_header header;
+
+		std::memset( &header, 0, sizeof( header ) );
+		std::memcpy( header.magic, "MOFLPOUT", 8 );
+		header.version = output_header::current_version;
+		header.byte_order = output_header::byte_order_mark;
+		header.num_objectives = _instance.num_objectives;
+		header.num_customers = _instance.num_customers;
+		header.num_facilities = _instance.num_facilities;
+		header.flags =
+			( _solutions ? output_header::has_solutions : 0 ) |
+			( _solutions && _solutions->single_source() ? output_header::single_source : 0 );
+
+		binary( header );
+	}
+
+	flush();
+}
+
+void front_writer::found( const flp_solver &, const std::vector<double> & z )
+{
+	lock_guard guard( _lock );
+
+	record( "point", &z[0] );
+	flush();
+}
+
+void front_writer::finish( const archive & pareto_front )
+{
+	lock_guard guard( _lock );
+
+	// Written at once, the points being known
+	for ( int index = 0; index < pareto_front.size(); ++index )
+	{
+		record( "nondominated", pareto_front[index] );
+	}
+
+	if ( _format == ndjson )
+	{
+		_buffer += "{\"type\":\"end\",\"points\":";
+		integer( pareto_front.size() );
+		_buffer += "}\n";
+	}
+	else if ( _format == bin )
+	{
+		binary( (uint32_t)output_header::record_end );
+	}
+
+	flush();
+}
+
+void front_writer::record( const char * type, const double * z )
+{
+	int index = ( _solutions ? _solutions->find( z ) : -1 );
+
+	if ( _format == ndjson )
+	{
+		_buffer += "{\"type\":\"";
+		_buffer += type;
+		_buffer += "\",\"z\":[";
+		for ( int k = 0; k < _instance.num_objectives; ++k )
+		{
+			if ( k > 0 )
+				_buffer += ',';
+			number( z[k] );
+		}
+		_buffer += ']';
+
+		if ( index >= 0 )
+			solution( index );
+
+		_buffer += "}\n";
+	}
+	else if ( _format == csv )
+	{
+		_buffer += type;
+		for ( int k = 0; k < _instance.num_objectives; ++k )
+		{
+			_buffer += ',';
+			number( z[k] );
+		}
+
+		if ( index >= 0 )
+			solution( index );
+		else if ( _solutions )
+			_buffer += ",,";
+
+		_buffer += '\n';
+	}
+	else
+	{
+		uint32_t record_type = ( std::strcmp( type, "point" ) == 0
+			? output_header::record_point : output_header::record_nondominated );
+
+		binary( (uint32_t)( index >= 0 ? record_type | output_header::has_solution : record_type ) );
+		for ( int k = 0; k < _instance.num_objectives; ++k )
+		{
+			binary( z[k] );
+		}
+
+		if ( index >= 0 )
+			solution( index );
+	}
+}
+
+void front_writer::solution( int index )
+{
+	const int m = _instance.num_customers;
+	const int n = _instance.num_facilities;
+	const bool single_source = _solutions->single_source();
+
+	std::vector< std::pair<int, double> > pairs;
+
+	// Open facilities
+	if ( _format == bin )
+	{
+		std::string bits( ( n + 7 ) / 8, '\0' );
+		for ( int j = 0; j < n; ++j )
+		{
+			if ( _solutions->open( index, j ) )
+				bits[j / 8] |= (char)( 1 << ( j % 8 ) );
+		}
+		_buffer += bits;
+	}
+	else
+	{
+		_buffer += ( _format == ndjson ? ",\"open\":[" : "," );
+		for ( int j = 0, count = 0; j < n; ++j )
+		{
+			if ( _solutions->open( index, j ) )
+			{
+				if ( count++ > 0 )
+					_buffer += ( _format == ndjson ? ',' : ' ' );
+				integer( j );
+			}
+		}
+		_buffer += ( _format == ndjson ? "],\"assign\":[" : "," );
+	}
+
+	// Assignments
+	for ( int i = 0; i < m; ++i )
+	{
+		if ( i > 0 && _format != bin )
+			_buffer += ( _format == ndjson ? ',' : ( single_source ? ' ' : ';' ) );
+
+		if ( single_source )
+		{
+			if ( _format == bin )
+				binary( (uint32_t)_solutions->facility( index, i ) );
+			else
+				integer( _solutions->facility( index, i ) );
+			continue;
+		}
+
+		// Sparse fractional assignment
+		_solutions->assignment( index, i, pairs );
+
+		if ( _format == bin )
+			binary( (uint32_t)pairs.size() );
+		else if ( _format == ndjson )
+			_buffer += '[';
+
+		for ( std::size_t pair = 0; pair < pairs.size(); ++pair )
+		{
+			if ( _format == bin )
+			{
+				binary( (uint32_t)pairs[pair].first );
+				binary( pairs[pair].second );
+			}
+			else if ( _format == ndjson )
+			{
+				_buffer += ( pair > 0 ? ",[" : "[" );
+				integer( pairs[pair].first );
+				_buffer += ',';
+				number( pairs[pair].second );
+				_buffer += ']';
+			}
+			else
+			{
+				if ( pair > 0 )
+					_buffer += ' ';
+				integer( pairs[pair].first );
+				_buffer += ':';
+				number( pairs[pair].second );
+			}
+		}
+
+		if ( _format == ndjson )
+			_buffer += ']';
+	}
+
+	if ( _format == ndjson )
+		_buffer += ']';
+}
+
+void front_writer::flush()
+{
+	_os.write( _buffer.data(), _buffer.size() );
+	_os.flush();
+	_buffer.clear();
+
+	if ( !_os )
+		throw std::runtime_error( "unable to write the output" );
+}
+
+void front_writer::number( double value )
+{
+	char text[32];
+
+	// Infinite or NaN
+	if ( _format == ndjson && !( std::fabs( value ) < HUGE_VAL ) )
+	{
+		_buffer += "null";
+		return;
+	}
+
+	std::sprintf( text, "%.17g", value );
+	_buffer += text;
+}
+
+void front_writer::integer( int value )
+{
+	char text[16];
+
+	std::sprintf( text, "%d", value );
+	_buffer += text;
+}
@@ -18,6 +18,8 @@
 
 problem::problem( int num_objectives, bool capacitated, bool single_source ) :
 	num_objectives( num_objectives ),
+	num_customers( 0 ),
+	num_facilities( 0 ),
 	capacitated( capacitated ),
 	single_source( single_source ),
 	D( 0. ),
@@ -27,6 +29,8 @@ problem::problem( int num_objectives, bool capacitated, bool single_source ) :
 
 problem::problem( bool capacitated, bool single_source ) :
 	num_objectives( 2 ),
+	num_customers( 0 ),
+	num_facilities( 0 ),
 	capacitated( capacitated ),
 	single_source( single_source ),
 	D( 0. ),
@@ -34,10 +38,15 @@ problem::problem( bool capacitated, bool single_source ) :
 {
 }
 
+void problem::resize_costs()
+{
+	costs.assign( (std::size_t)num_objectives * num_customers * num_facilities, 0. );
+}
+
 std::istream & operator >> ( std::istream & is, problem & instance )
 {
 	// Reset all
-	instance.c.clear();
+	instance.costs.clear();
 	instance.f.clear();
 	instance.d.clear();
 	instance.q.clear();
@@ -49,9 +58,7 @@ std::istream & operator >> ( std::istream & is, problem & instance )
 	is >> instance.num_facilities;
 
 	// Resize assignment costs
-	instance.c.resize( instance.num_objectives,
-		std::vector< std::vector<double> >( instance.num_customers,
-		std::vector<double>( instance.num_facilities, 0 ) ) );
+	instance.resize_costs();
 
 	// Resize opening costs
 	instance.f.resize( instance.num_objectives, std::vector<double>( instance.num_facilities, 0 ) );
@@ -60,16 +67,10 @@ std::istream & operator >> ( std::istream & is, problem & instance )
 	instance.d.resize( instance.num_customers, 0 );
 	instance.q.resize( instance.num_facilities, std::numeric_limits<double>::infinity() );
 
-	// Read assignment costs
-	for ( int k = 0; k < instance.num_objectives; ++k )
+	// Read assignment costs, stored in the same order as in the file
+	for ( std::size_t index = 0; index < instance.costs.size(); ++index )
 	{
-		for ( int i = 0; i < instance.num_customers; ++i )
-		{
-			for ( int j = 0; j < instance.num_facilities; ++j )
-			{
-				is >> instance.c[k][i][j];
-			}
-		}
+		is >> instance.costs[index];
 	}
 
 	// Read opening costs
@@ -118,7 +119,7 @@ std::ostream & operator << ( std::ostream & os, const problem & instance )
 			for ( int j = 0; j < instance.num_facilities; ++j )
 			{
 				if ( j > 0 ) os << ' ';
-				os << instance.c[k][i][j];
+				os << instance.c( k, i, j );
 			}
 			os << std::endl;
 		}
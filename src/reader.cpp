@@ -0,0 +1,333 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "reader.hpp"
+#include "binary.hpp"
+#include <sstream>
+#include <limits>
+#include <cstdlib>
+
+namespace
+{
+
+// Powers of ten exactly representable as a double
+const double pow10[] = {
+	1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// Largest mantissa converted exactly to a double
+const unsigned long max_exact = 1ul << 53;
+
+/*
+	Class: scanner
+
+	Scan whitespace separated numbers from a memory buffer.
+*/
+class scanner
+{
+public:
+	scanner( const char * begin, const char * end ) : _begin( begin ), _end( end ), _pos( begin ) {}
+
+	/*
+		Method: number
+
+		Scan a decimal number such as -12, 3.5 or 1e-3.
+
+		Parameters:
+			what - Description of the number, used in error messages.
+	*/
+	double number( const char * what );
+
+	/*
+		Method: integer
+
+		Scan a positive integer.
+	*/
+	int integer( const char * what );
+
+	/*
+		Method: error
+
+		Throw a parse_error at the current position.
+	*/
+	void error( const std::string & message ) const;
+
+private:
+	const char * _begin, * _end, * _pos;
+
+	void skip_whitespace();
+	static bool is_space( char c );
+	static bool is_digit( char c );
+};
+
+inline bool scanner::is_space( char c )
+{
+	return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+inline bool scanner::is_digit( char c )
+{
+	return (unsigned)( c - '0' ) < 10u;
+}
+
+inline void scanner::skip_whitespace()
+{
+	while ( _pos != _end && is_space( *_pos ) )
+		++_pos;
+}
+
+double scanner::number( const char * what )
+{
+	skip_whitespace();
+
+	const char * start = _pos;
+	unsigned long mantissa( 0 );
+	int digits( 0 ), exponent( 0 );
+	bool negative( false ), any( false );
+
+	if ( _pos == _end )
+		error( std::string( "unexpected end of file, expected " ) + what );
+
+	if ( *_pos == '-' || *_pos == '+' )
+	{
+		negative = ( *_pos == '-' );
+		++_pos;
+	}
+
+	// Integer part, digits beyond the precision only scale the value
+	for ( ; _pos != _end && is_digit( *_pos ); ++_pos, any = true )
+	{
+		if ( digits < std::numeric_limits<unsigned long>::digits10 )
+		{
+			mantissa = mantissa * 10 + ( *_pos - '0' );
+			if ( mantissa ) ++digits;
+		}
+		else
+		{
+			++exponent;
+		}
+	}
+
+	// Fractional part
+	if ( _pos != _end && *_pos == '.' )
+	{
+		for ( ++_pos; _pos != _end && is_digit( *_pos ); ++_pos, any = true )
+		{
+			if ( digits < std::numeric_limits<unsigned long>::digits10 )
+			{
+				mantissa = mantissa * 10 + ( *_pos - '0' );
+				if ( mantissa ) ++digits;
+				--exponent;
+			}
+		}
+	}
+
+	if ( !any )
+	{
+		_pos = start;
+		error( std::string( "expected " ) + what );
+	}
+
+	// Exponent
+	if ( _pos != _end && ( *_pos == 'e' || *_pos == 'E' ) )
+	{
+		int sign( 1 ), value( 0 );
+		++_pos;
+
+		if ( _pos != _end && ( *_pos == '-' || *_pos == '+' ) )
+		{
+			sign = ( *_pos == '-' ? -1 : 1 );
+			++_pos;
+		}
+
+		if ( _pos == _end || !is_digit( *_pos ) )
+			error( "malformed exponent" );
+
+		for ( ; _pos != _end && is_digit( *_pos ); ++_pos )
+		{
+			if ( value < 100000 )
+				value = value * 10 + ( *_pos - '0' );
+		}
+		exponent += sign * value;
+	}
+
+	if ( _pos != _end && !is_space( *_pos ) )
+		error( std::string( "unexpected character in " ) + what );
+
+	double result;
+
+	if ( mantissa == 0 )
+	{
+		result = 0.;
+	}
+	else if ( mantissa <= max_exact && exponent >= -22 && exponent <= 22 )
+	{
+		// Both operands are exact, so the result is correctly rounded
+		result = ( exponent < 0 )
+			? (double)mantissa / pow10[-exponent]
+			: (double)mantissa * pow10[exponent];
+	}
+	else
+	{
+		// Rare cases (long mantissas, huge exponents) need a careful conversion
+		result = std::strtod( std::string( start, _pos ).c_str(), 0 );
+		return result;
+	}
+
+	return negative ? -result : result;
+}
+
+int scanner::integer( const char * what )
+{
+	const char * start = ( skip_whitespace(), _pos );
+	double value = number( what );
+
+	// (int)value is undefined out of the range of int
+	if ( !( value >= 1. && value <= std::numeric_limits<int>::max() ) || value != (int)value )
+	{
+		_pos = start;
+		error( std::string( "expected a positive integer for " ) + what );
+	}
+	return (int)value;
+}
+
+void scanner::error( const std::string & message ) const
+{
+	int line( 1 ), column( 1 );
+
+	// Locate the error only when it happens
+	for ( const char * p = _begin; p != _pos; ++p )
+	{
+		if ( *p == '\n' )
+		{
+			++line;
+			column = 1;
+		}
+		else
+		{
+			++column;
+		}
+	}
+
+	std::ostringstream what;
+	what << line << ":" << column << ": " << message;
+	throw parse_error( what.str(), line, column );
+}
+
+}
+
+parse_error::parse_error( const std::string & what, int line, int column ) :
+	std::runtime_error( what ),
+	_line( line ),
+	_column( column )
+{
+}
+
+void read_instance( const std::string & filename, problem & instance )
+{
+	mapped_file file( filename );
+
+	try
+	{
+		read_instance( file.data(), file.data() + file.size(), instance );
+	}
+	catch ( const parse_error & e )
+	{
+		throw parse_error( filename + ":" + e.what(), e.line(), e.column() );
+	}
+}
+
+void load_instance( const std::string & filename, mapped_file & file, problem & instance )
+{
+	file.open( filename );
+
+	try
+	{
+		if ( is_binary_instance( file ) )
+			map_binary_instance( file, instance );
+		else
+			read_instance( file.data(), file.data() + file.size(), instance );
+	}
+	catch ( const parse_error & e )
+	{
+		throw parse_error( filename + ":" + e.what(), e.line(), e.column() );
+	}
+	catch ( const std::runtime_error & e )
+	{
+		throw std::runtime_error( filename + ": " + e.what() );
+	}
+}
+
+void read_instance( const char * begin, const char * end, problem & instance )
+{
+	scanner scan( begin, end );
+
+	// Reset all
+	instance.costs.clear();
+	instance.f.clear();
+	instance.d.clear();
+	instance.q.clear();
+	instance.D = 0.;
+	instance.Q = std::numeric_limits<double>::infinity();
+
+	if ( instance.num_objectives <= 0 )
+		scan.error( "invalid number of objectives" );
+
+	// Number of customers and facilities
+	instance.num_customers = scan.integer( "the number of customers" );
+	instance.num_facilities = scan.integer( "the number of facilities" );
+
+	// Resize
+	instance.resize_costs();
+	instance.f.assign( instance.num_objectives, std::vector<double>( instance.num_facilities, 0 ) );
+	instance.d.assign( instance.num_customers, 0 );
+	instance.q.assign( instance.num_facilities, std::numeric_limits<double>::infinity() );
+
+	// Read assignment costs, stored in the same order as in the file
+	double * c = instance.costs.data();
+	for ( std::size_t index = 0; index < instance.costs.size(); ++index )
+	{
+		c[index] = scan.number( "an assignment cost" );
+	}
+
+	// Read opening costs
+	for ( int k = 0; k < instance.num_objectives; ++k )
+	{
+		for ( int j = 0; j < instance.num_facilities; ++j )
+		{
+			instance.f[k][j] = scan.number( "an opening cost" );
+		}
+	}
+
+	// Read CFLP additional information
+	if ( instance.capacitated )
+	{
+		// Read demands
+		for ( int i = 0; i < instance.num_customers; ++i )
+		{
+			instance.d[i] = scan.number( "a demand" );
+			instance.D += instance.d[i];
+		}
+
+		// Read capacities
+		instance.Q = 0.;
+		for ( int j = 0; j < instance.num_facilities; ++j )
+		{
+			instance.q[j] = scan.number( "a capacity" );
+			instance.Q += instance.q[j];
+		}
+	}
+}
@@ -0,0 +1,505 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "server.hpp"
+#include "problem.hpp"
+#include "flp_solver.hpp"
+#include "argument.hpp"
+#include "archive.hpp"
+#include "methods.hpp"
+#include "reader.hpp"
+#include "budget.hpp"
+#include "lower_bound_set.hpp"
+#include "candidate_pool.hpp"
+#include "checkpoint.hpp"
+#include "thread.hpp"
+#include "timer.hpp"
+#include "json.hpp"
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <cerrno>
+#include <cstring>
+#include <csignal>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+/*
+	Class: connection
+
+	Line oriented input and output on file descriptors, which are not
+	closed. Outputs can be written by several threads.
+*/
+class connection
+{
+public:
+	/*
+		Constructor: connection
+	*/
+	connection( int in, int out );
+
+	/*
+		Method: read_line
+
+		Returns:
+			false at the end of the input or on SIGINT/SIGTERM.
+	*/
+	bool read_line( std::string & line );
+
+	/*
+		Method: read
+
+		Read exactly size bytes.
+
+		Returns:
+			false at the end of the input or on SIGINT/SIGTERM.
+	*/
+	bool read( std::size_t size, std::string & data );
+
+	/*
+		Method: write
+
+		Write at once. Throw std::runtime_error on failure.
+	*/
+	void write( const std::string & data );
+
+private:
+	int _in, _out;
+	std::string _buffer;   // Read but not consumed
+	mutex _lock;           // Protect _out
+
+	/*
+		Method: fill
+
+		Read more input into the buffer.
+
+		Returns:
+			false at the end of the input or on SIGINT/SIGTERM.
+	*/
+	bool fill();
+
+	// Non copyable
+	connection( const connection & );
+	connection & operator = ( const connection & );
+};
+
+/*
+	Class: connection_observer
+
+	Send the points found to a connection.
+*/
+class connection_observer : public point_observer
+{
+public:
+	explicit connection_observer( connection & client ) : _client( client ) {}
+
+	void found( const flp_solver & solve, const std::vector<double> & z );
+
+private:
+	connection & _client;
+};
+
+/*
+	Class: server_cache
+
+	The last instance and its model.
+*/
+struct server_cache
+{
+	std::string hash;                   // See checkpoint::instance_hash
+	std::auto_ptr<mapped_file> file;    // Mapping of a binary instance
+	std::auto_ptr<problem> instance;
+	std::auto_ptr<flp_solver> solve;
+};
+
+/*
+	Function: wait_input
+
+	Wait until a file descriptor can be read.
+
+	Returns:
+		false on SIGINT/SIGTERM.
+*/
+static bool wait_input( int fd );
+
+/*
+	Function: serve_connection
+
+	Answer the requests of a connection.
+
+	Returns:
+		false if the server must stop.
+*/
+static bool serve_connection( connection & client, server_cache & cache, trace_writer * trace );
+
+/*
+	Function: solve_request
+
+	Answer a solve or open request.
+*/
+static void solve_request( connection & client, std::istringstream & request, bool inline_instance,
+	server_cache & cache, trace_writer * trace );
+
+/*
+	Function: send_error
+*/
+static void send_error( connection & client, const std::string & message );
+
+////////////////////////////////////////////////////////////////////////////////
+
+connection::connection( int in, int out ) :
+	_in( in ),
+	_out( out ),
+	_buffer(),
+	_lock()
+{
+}
+
+bool connection::read_line( std::string & line )
+{
+	std::string::size_type end;
+
+	while ( ( end = _buffer.find( '\n' ) ) == std::string::npos )
+	{
+		if ( !fill() )
+			return false;
+	}
+
+	line.assign( _buffer, 0, end );
+	_buffer.erase( 0, end + 1 );
+	return true;
+}
+
+bool connection::read( std::size_t size, std::string & data )
+{
+	while ( _buffer.size() < size )
+	{
+		if ( !fill() )
+			return false;
+	}
+
+	data.assign( _buffer, 0, size );
+	_buffer.erase( 0, size );
+	return true;
+}
+
+void connection::write( const std::string & data )
+{
+	lock_guard guard( _lock );
+
+	for ( std::size_t done = 0; done < data.size(); )
+	{
+		ssize_t count = ::write( _out, data.data() + done, data.size() - done );
+		if ( count < 0 )
+		{
+			if ( errno == EINTR )
+				continue;
+			throw std::runtime_error( "unable to write a response" );
+		}
+		done += count;
+	}
+}
+
+bool connection::fill()
+{
+	char chunk[4096];
+
+	for ( ;; )
+	{
+		if ( !wait_input( _in ) )
+			return false;
+
+		ssize_t count = ::read( _in, chunk, sizeof( chunk ) );
+		if ( count < 0 && errno == EINTR )
+			continue;
+		if ( count <= 0 )
+			return false;
+
+		_buffer.append( chunk, count );
+		return true;
+	}
+}
+
+void connection_observer::found( const flp_solver &, const std::vector<double> & z )
+{
+	std::ostringstream os;
+
+	os.precision( 15 );
+	os << "{\"event\":\"point\",\"point\":";
+	write_json_array( os, &z[0], z.size() );
+	os << "}\n";
+
+	_client.write( os.str() );
+}
+
+void serve( const std::string & address, trace_writer * trace )
+{
+	server_cache cache;
+
+	// a client gone while writing is an EPIPE error, not the end of the server
+	std::signal( SIGPIPE, SIG_IGN );
+
+	if ( address.empty() )
+	{
+		connection client( STDIN_FILENO, STDOUT_FILENO );
+		serve_connection( client, cache, trace );
+		return;
+	}
+
+	struct sockaddr_un name;
+
+	if ( address.size() >= sizeof( name.sun_path ) )
+		throw std::runtime_error( "socket path too long: " + address );
+
+	std::memset( &name, 0, sizeof( name ) );
+	name.sun_family = AF_UNIX;
+	std::strcpy( name.sun_path, address.c_str() );
+
+	int fd = socket( AF_UNIX, SOCK_STREAM, 0 );
+	if ( fd < 0 )
+		throw std::runtime_error( "unable to create a socket" );
+
+	// replace the socket of a previous server
+	unlink( address.c_str() );
+
+	if ( bind( fd, (struct sockaddr *)&name, sizeof( name ) ) != 0 || listen( fd, 16 ) != 0 )
+	{
+		close( fd );
+		throw std::runtime_error( "unable to listen on " + address );
+	}
+
+	// connections are served one after the other, the others wait
+	for ( bool running = true; running && wait_input( fd ); )
+	{
+		int client_fd = accept( fd, 0, 0 );
+		if ( client_fd < 0 )
+			continue;
+
+		connection client( client_fd, client_fd );
+
+		try
+		{
+			running = serve_connection( client, cache, trace );
+		}
+		catch ( const std::exception & )
+		{
+			// the client has gone, wait for the next one
+		}
+
+		close( client_fd );
+	}
+
+	close( fd );
+	unlink( address.c_str() );
+}
+
+bool wait_input( int fd )
+{
+	struct pollfd input;
+
+	input.fd = fd;
+	input.events = POLLIN;
+
+	// wake up from time to time to check the signals
+	while ( !budget::signaled() )
+	{
+		input.revents = 0;
+		if ( poll( &input, 1, 200 ) > 0 )
+			return true;
+	}
+	return false;
+}
+
+bool serve_connection( connection & client, server_cache & cache, trace_writer * trace )
+{
+	std::string line;
+
+	while ( client.read_line( line ) )
+	{
+		std::istringstream request( line );
+		std::string command;
+
+		if ( !( request >> command ) )
+			continue;
+
+		if ( command == "quit" )
+			return false;
+
+		if ( command == "solve" || command == "open" )
+			solve_request( client, request, command == "solve", cache, trace );
+		else
+			send_error( client, "unknown command " + command );
+	}
+
+	return !budget::signaled();
+}
+
+void solve_request( connection & client, std::istringstream & request, bool inline_instance,
+	server_cache & cache, trace_writer * trace )
+{
+	std::string method, source, option;
+	double time_limit = argument::time_limit;
+	int node_limit = argument::node_limit;
+
+	request >> method >> source;
+
+	// the payload must be consumed even if the request is invalid
+	std::string payload;
+	if ( inline_instance )
+	{
+		std::size_t size = 0;
+		std::istringstream( source ) >> size;
+		if ( !client.read( size, payload ) )
+			return;
+	}
+
+	if ( method != "lexicographic" && method != "weighted-sum"
+		&& method != "supported" && method != "efficient" )
+	{
+		send_error( client, "unknown method " + method );
+		return;
+	}
+
+	while ( request >> option )
+	{
+		if ( option.compare( 0, 11, "time-limit=" ) == 0 )
+			std::istringstream( option.substr( 11 ) ) >> time_limit;
+		else if ( option.compare( 0, 11, "node-limit=" ) == 0 )
+			std::istringstream( option.substr( 11 ) ) >> node_limit;
+		else
+		{
+			send_error( client, "unknown option " + option );
+			return;
+		}
+	}
+
+	try
+	{
+		std::auto_ptr<mapped_file> file( new mapped_file );
+		std::auto_ptr<problem> instance( new problem( argument::objectives,
+			(bool)argument::capacitated, (bool)argument::single_source ) );
+
+		if ( inline_instance )
+			read_instance( payload.data(), payload.data() + payload.size(), *instance );
+		else
+			load_instance( source, *file, *instance );
+
+		// build the model unless the instance is the cached one
+		std::string hash = checkpoint::instance_hash( *instance );
+
+		if ( !cache.solve.get() || hash != cache.hash )
+		{
+			cache.solve.reset();
+			cache.instance = instance;
+			cache.file = file;
+			cache.hash = hash;
+			cache.solve.reset( new flp_solver( *cache.instance, argument::relaxation, argument::lazy_opening ) );
+			cache.solve->set_verblevel( argument::verblevel );
+			cache.solve->set_warm_start( argument::warm_start );
+			cache.solve->set_reoptimization( argument::reopt );
+			cache.solve->set_dual_extraction( argument::relaxation );
+			cache.solve->set_heuristic( argument::heuristic );
+			cache.solve->set_trace( trace );
+		}
+
+		flp_solver & solve = *cache.solve;
+		budget limits( time_limit, node_limit );
+		lower_bound_set bounds;
+		candidate_pool candidates( solve.instance.num_objectives );
+		connection_observer observer( client );
+		timer wall;
+
+		// forget what the previous request has left
+		solve.reset_statistics();
+		solve.set_start( std::vector<double>() );
+		solve.set_main_objective( 0 );
+		solve.set_augmentation( 0. );
+		solve.set_budget( &limits );
+		solve.set_lower_bound_set( &bounds );
+		solve.set_observer( &observer );
+		solve.set_candidate_pool( argument::harvest ? &candidates : 0 );
+
+		archive pareto_front;
+		std::string error;
+
+		try
+		{
+			pareto_front = run_method( solve, method );
+		}
+		catch ( const std::exception & e )
+		{
+			error = e.what();
+		}
+
+		solve.set_observer( 0 );
+		solve.set_candidate_pool( 0 );
+		solve.set_lower_bound_set( 0 );
+		solve.set_budget( 0 );
+
+		// SCIP may be left in any stage by an error, the next request rebuilds
+		// the model
+		if ( !error.empty() )
+		{
+			cache.solve.reset();
+			cache.hash.clear();
+			throw std::runtime_error( error );
+		}
+
+		// the points of a stopped front are not all proven efficient
+		if ( limits.exhausted() && argument::harvest )
+			candidates.merge( pareto_front );
+
+		std::ostringstream os;
+		const solver_statistics & statistics = solve.statistics();
+
+		os.precision( 15 );
+		os << "{\"event\":\"done\",\"status\":";
+		write_json_string( os, limits.exhausted() ? limits.reason() : "complete" );
+		os
+			<< ",\"build_time\":" << solve.get_build_time()
+			<< ",\"wall_time\":" << wall.elapsed()
+			<< ",\"solves\":" << statistics.solves
+			<< ",\"nodes\":" << statistics.nodes
+			<< ",\"lp_iterations\":" << statistics.lp_iterations
+			<< ",\"points\":[";
+
+		for ( int index = 0; index < pareto_front.size(); ++index )
+		{
+			if ( index > 0 )
+				os << ',';
+			write_json_array( os, pareto_front[index], pareto_front.dimension() );
+		}
+
+		os << "]}\n";
+		client.write( os.str() );
+	}
+	catch ( const std::exception & e )
+	{
+		send_error( client, e.what() );
+	}
+}
+
+void send_error( connection & client, const std::string & message )
+{
+	std::ostringstream os;
+
+	os << "{\"event\":\"error\",\"message\":";
+	write_json_string( os, message );
+	os << "}\n";
+
+	client.write( os.str() );
+}
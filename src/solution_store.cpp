@@ -0,0 +1,328 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "solution_store.hpp"
+#include "flp_solver.hpp"
+#include <fstream>
+#include <stdexcept>
+#include <cstring>
+
+static const char solution_magic[8] = { 'M', 'O', 'F', 'L', 'P', 'S', 'O', 'L' };
+
+// Below this value, an assignment is zero
+static const double assignment_tolerance = 1e-9;
+
+// Read a value of a solution file
+template <typename T>
+static void read_value( std::ifstream & is, T & value )
+{
+	if ( !is.read( reinterpret_cast<char *>( &value ), sizeof( T ) ) )
+		throw std::runtime_error( "truncated solution file" );
+}
+
+// Write a value of a solution file
+template <typename T>
+static void write_value( std::ofstream & os, const T & value )
+{
+	os.write( reinterpret_cast<const char *>( &value ), sizeof( T ) );
+}
+
+solution_store::solution_store( const problem & instance, bool single_source ) :
+	_instance( instance ),
+	_single_source( single_source ),
+	_bitset_size( ( instance.num_facilities + 7 ) / 8 ),
+	_points(),
+	_open(),
+	_facility(),
+	_value(),
+	_start( 1, 0 ),
+	_index(),
+	_lock()
+{
+}
+
+void solution_store::insert( const flp_solver & solve, const std::vector<double> & z )
+{
+	lock_guard guard( _lock );
+
+	const int m = _instance.num_customers;
+	const int n = _instance.num_facilities;
+
+	if ( _index.find( z ) != _index.end() )
+		return;
+
+	_index[z] = size();
+	_points.insert( _points.end(), z.begin(), z.end() );
+
+	// Open facilities
+	std::size_t offset = _open.size();
+	_open.resize( offset + _bitset_size, 0 );
+	for ( int j = 0; j < n; ++j )
+	{
+		if ( solve.y( j ) )
+			_open[offset + j / 8] |= (unsigned char)( 1 << ( j % 8 ) );
+	}
+
+	// Assignments
+	for ( int i = 0; i < m; ++i )
+	{
+		if ( _single_source )
+		{
+			int facility = 0;
+			for ( int j = 1; j < n; ++j )
+			{
+				if ( solve.x_real( i, j ) > solve.x_real( i, facility ) )
+					facility = j;
+			}
+			_facility.push_back( facility );
+			continue;
+		}
+
+		for ( int j = 0; j < n; ++j )
+		{
+			double value = solve.x_real( i, j );
+			if ( value > assignment_tolerance )
+			{
+				_facility.push_back( j );
+				_value.push_back( value );
+			}
+		}
+		_start.push_back( _facility.size() );
+	}
+}
+
+void solution_store::retain( const archive & front )
+{
+	const int p = _instance.num_objectives;
+	const int m = _instance.num_customers;
+
+	std::vector<double> points;
+	std::vector<unsigned char> open;
+	std::vector<uint32_t> facility;
+	std::vector<double> value;
+	std::vector<std::size_t> start( 1, 0 );
+	std::vector<double> z;
+
+	// Copy the solutions in the order of the front
+	for ( int index = 0; index < front.size(); ++index )
+	{
+		front.point( index, z );
+
+		std::map<std::vector<double>, int>::const_iterator it = _index.find( z );
+		if ( it == _index.end() )
+			continue;
+
+		int old = it->second;
+
+		points.insert( points.end(), _points.begin() + (std::size_t)old * p, _points.begin() + (std::size_t)( old + 1 ) * p );
+		open.insert( open.end(), _open.begin() + old * _bitset_size, _open.begin() + ( old + 1 ) * _bitset_size );
+
+		if ( _single_source )
+		{
+			facility.insert( facility.end(), _facility.begin() + (std::size_t)old * m, _facility.begin() + (std::size_t)( old + 1 ) * m );
+			continue;
+		}
+
+		for ( int i = 0; i < m; ++i )
+		{
+			std::size_t begin = customer_begin( old, i ), end = customer_begin( old, i+1 );
+
+			facility.insert( facility.end(), _facility.begin() + begin, _facility.begin() + end );
+			value.insert( value.end(), _value.begin() + begin, _value.begin() + end );
+			start.push_back( facility.size() );
+		}
+	}
+
+	_points.swap( points );
+	_open.swap( open );
+	_facility.swap( facility );
+	_value.swap( value );
+	_start.swap( start );
+	reindex();
+}
+
+void solution_store::clear()
+{
+	_points.clear();
+	_open.clear();
+	_facility.clear();
+	_value.clear();
+	_start.assign( 1, 0 );
+	_index.clear();
+}
+
+int solution_store::find( const double * z ) const
+{
+	std::map<std::vector<double>, int>::const_iterator it =
+		_index.find( std::vector<double>( z, z + _instance.num_objectives ) );
+
+	return ( it != _index.end() ? it->second : -1 );
+}
+
+void solution_store::assignment( int index, int i, std::vector< std::pair<int, double> > & pairs ) const
+{
+	pairs.clear();
+
+	if ( _single_source )
+	{
+		pairs.push_back( std::make_pair( facility( index, i ), 1. ) );
+		return;
+	}
+
+	for ( std::size_t pair = customer_begin( index, i ); pair < customer_begin( index, i+1 ); ++pair )
+	{
+		pairs.push_back( std::make_pair( (int)_facility[pair], _value[pair] ) );
+	}
+}
+
+std::size_t solution_store::bytes() const
+{
+	return _points.size() * sizeof( double )
+		+ _open.size()
+		+ _facility.size() * sizeof( uint32_t )
+		+ _value.size() * sizeof( double )
+		+ _start.size() * sizeof( std::size_t );
+}
+
+void solution_store::write( const std::string & filename ) const
+{
+	const int m = _instance.num_customers;
+
+	std::ofstream os( filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc );
+
+	if ( !os )
+		throw std::runtime_error( "unable to open '" + filename + "'" );
+
+	solution_header header;
+
+	std::memset( &header, 0, sizeof( header ) );
+	std::memcpy( header.magic, solution_magic, sizeof( solution_magic ) );
+	header.version = solution_header::current_version;
+	header.byte_order = solution_header::byte_order_mark;
+	header.num_objectives = _instance.num_objectives;
+	header.num_customers = m;
+	header.num_facilities = _instance.num_facilities;
+	header.single_source = _single_source;
+	header.size = size();
+
+	write_value( os, header );
+
+	for ( int index = 0; index < size(); ++index )
+	{
+		os.write( reinterpret_cast<const char *>( point( index ) ), _instance.num_objectives * sizeof( double ) );
+		os.write( reinterpret_cast<const char *>( &_open[index * _bitset_size] ), _bitset_size );
+
+		if ( _single_source )
+		{
+			os.write( reinterpret_cast<const char *>( &_facility[(std::size_t)index * m] ), m * sizeof( uint32_t ) );
+			continue;
+		}
+
+		for ( int i = 0; i < m; ++i )
+		{
+			std::size_t begin = customer_begin( index, i );
+			uint32_t count = customer_begin( index, i+1 ) - begin;
+
+			write_value( os, count );
+			if ( count > 0 )
+			{
+				os.write( reinterpret_cast<const char *>( &_facility[begin] ), count * sizeof( uint32_t ) );
+				os.write( reinterpret_cast<const char *>( &_value[begin] ), count * sizeof( double ) );
+			}
+		}
+	}
+
+	if ( !os.flush() )
+		throw std::runtime_error( "unable to write '" + filename + "'" );
+}
+
+void solution_store::read( const std::string & filename )
+{
+	const int p = _instance.num_objectives;
+	const int m = _instance.num_customers;
+
+	std::ifstream is( filename.c_str(), std::ios::in | std::ios::binary );
+
+	if ( !is )
+		throw std::runtime_error( "unable to open '" + filename + "'" );
+
+	solution_header header;
+	read_value( is, header );
+
+	if ( std::memcmp( header.magic, solution_magic, sizeof( solution_magic ) ) != 0 )
+		throw std::runtime_error( "not a solution file" );
+
+	if ( header.byte_order != solution_header::byte_order_mark )
+		throw std::runtime_error( "solution file written with another byte order" );
+
+	if ( header.version != solution_header::current_version )
+		throw std::runtime_error( "unsupported solution file version" );
+
+	if ( (int)header.num_objectives != p || (int)header.num_customers != m
+		|| (int)header.num_facilities != _instance.num_facilities
+		|| (bool)header.single_source != _single_source )
+		throw std::runtime_error( "solution file of another problem" );
+
+	clear();
+
+	_points.resize( (std::size_t)header.size * p );
+	_open.resize( header.size * _bitset_size );
+	if ( _single_source )
+		_facility.resize( (std::size_t)header.size * m );
+
+	for ( uint32_t index = 0; index < header.size; ++index )
+	{
+		for ( int k = 0; k < p; ++k )
+			read_value( is, _points[(std::size_t)index * p + k] );
+
+		for ( std::size_t byte = 0; byte < _bitset_size; ++byte )
+			read_value( is, _open[index * _bitset_size + byte] );
+
+		for ( int i = 0; i < m; ++i )
+		{
+			if ( _single_source )
+			{
+				read_value( is, _facility[(std::size_t)index * m + i] );
+				continue;
+			}
+
+			uint32_t count;
+			read_value( is, count );
+
+			std::size_t begin = _facility.size();
+			_facility.resize( begin + count );
+			_value.resize( begin + count );
+
+			for ( uint32_t pair = 0; pair < count; ++pair )
+				read_value( is, _facility[begin + pair] );
+			for ( uint32_t pair = 0; pair < count; ++pair )
+				read_value( is, _value[begin + pair] );
+
+			_start.push_back( _facility.size() );
+		}
+	}
+
+	reindex();
+}
+
+void solution_store::reindex()
+{
+	_index.clear();
+
+	for ( int index = 0; index < size(); ++index )
+	{
+		_index[std::vector<double>( point( index ), point( index ) + _instance.num_objectives )] = index;
+	}
+}
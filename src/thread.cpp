@@ -0,0 +1,64 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "thread.hpp"
+#include <vector>
+#include <iostream>
+#include <cstdlib>
+
+mutex::mutex()
+{
+	pthread_mutex_init( &_mutex, 0 );
+}
+
+mutex::~mutex()
+{
+	pthread_mutex_destroy( &_mutex );
+}
+
+condition::condition()
+{
+	pthread_cond_init( &_cond, 0 );
+}
+
+condition::~condition()
+{
+	pthread_cond_destroy( &_cond );
+}
+
+void run_threads( int num_threads, void * (*routine)( void * ), void * arg )
+{
+	if ( num_threads <= 1 )
+	{
+		routine( arg );
+		return;
+	}
+
+	std::vector<pthread_t> threads( num_threads );
+
+	for ( int t = 0; t < num_threads; ++t )
+	{
+		if ( pthread_create( &threads[t], 0, routine, arg ) != 0 )
+		{
+			std::cerr << "Error: unable to create thread" << std::endl;
+			std::abort();
+		}
+	}
+
+	for ( int t = 0; t < num_threads; ++t )
+	{
+		pthread_join( threads[t], 0 );
+	}
+}
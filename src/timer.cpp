@@ -0,0 +1,39 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "timer.hpp"
+#include <sys/time.h>
+
+timer::timer() :
+	_start( now() )
+{
+}
+
+void timer::restart()
+{
+	_start = now();
+}
+
+double timer::elapsed() const
+{
+	return now() - _start;
+}
+
+double timer::now()
+{
+	struct timeval tv;
+	gettimeofday( &tv, 0 );
+	return tv.tv_sec + tv.tv_usec * 1e-6;
+}
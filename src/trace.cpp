@@ -0,0 +1,170 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "trace.hpp"
+#include "json.hpp"
+#include <sstream>
+#include <stdexcept>
+#include <limits>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/resource.h>
+
+trace_record::trace_record() :
+	scalarization( "" ),
+	lambda( 0. ),
+	epsilon( std::numeric_limits<double>::infinity() ),
+	lower( -std::numeric_limits<double>::infinity() ),
+	presolve_time( 0. ),
+	solve_time( 0. ),
+	dual_time( 0. ),
+	free_time( 0. ),
+	nodes( 0 ),
+	lp_iterations( 0 ),
+	gap( 0. ),
+	dual_bound( -std::numeric_limits<double>::infinity() ),
+	status( "" ),
+	objectives()
+{
+}
+
+trace_writer::trace_writer( const std::string & filename ) :
+	_fd( -1 ),
+	_owned( false )
+{
+	open( filename );
+}
+
+trace_writer::trace_writer( int fd ) :
+	_fd( fd ),
+	_owned( false )
+{
+}
+
+trace_writer::~trace_writer()
+{
+	close();
+}
+
+void trace_writer::open( const std::string & filename )
+{
+	close();
+
+	if ( filename == "-" )
+	{
+		_fd = STDOUT_FILENO;
+	}
+	else if ( filename.compare( 0, 3, "fd:" ) == 0 )
+	{
+		std::istringstream( filename.substr( 3 ) ) >> _fd;
+		if ( _fd < 0 || fcntl( _fd, F_GETFD ) < 0 )
+		{
+			_fd = -1;
+			throw std::runtime_error( "invalid file descriptor '" + filename + "'" );
+		}
+	}
+	else
+	{
+		_fd = ::open( filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+		if ( _fd < 0 )
+			throw std::runtime_error( "unable to open '" + filename + "'" );
+		_owned = true;
+	}
+}
+
+void trace_writer::close()
+{
+	if ( _owned )
+		::close( _fd );
+
+	_fd = -1;
+	_owned = false;
+}
+
+void trace_writer::write( const trace_record & record )
+{
+	std::ostringstream os;
+	struct rusage usage;
+
+	getrusage( RUSAGE_SELF, &usage );
+
+	// objective values and epsilons need more than 6 digits
+	os.precision( 15 );
+	os << "{\"scalarization\":\"" << record.scalarization << '"';
+
+	if ( record.scalarization == std::string( "weighted_sum" ) )
+	{
+		os << ",\"lambda\":";
+		write_json_number( os, record.lambda );
+	}
+	else
+	{
+		os << ",\"epsilon\":";
+		write_json_number( os, record.epsilon );
+		os << ",\"lower\":";
+		write_json_number( os, record.lower );
+
+		if ( !record.epsilons.empty() )
+		{
+			os << ",\"epsilons\":[";
+			for ( std::size_t k = 0; k < record.epsilons.size(); ++k )
+			{
+				if ( k > 0 )
+					os << ',';
+				write_json_number( os, record.epsilons[k] );
+			}
+			os << ']';
+		}
+	}
+
+	os << ",\"presolve_time\":" << record.presolve_time
+		<< ",\"solve_time\":" << record.solve_time
+		<< ",\"dual_time\":" << record.dual_time
+		<< ",\"free_time\":" << record.free_time
+		<< ",\"nodes\":" << record.nodes
+		<< ",\"lp_iterations\":" << record.lp_iterations
+		<< ",\"gap\":";
+	write_json_number( os, record.gap );
+	os << ",\"dual_bound\":";
+	write_json_number( os, record.dual_bound );
+	os << ",\"status\":\"" << record.status << '"'
+		<< ",\"objectives\":[";
+
+	for ( std::size_t k = 0; k < record.objectives.size(); ++k )
+	{
+		if ( k > 0 )
+			os << ',';
+		write_json_number( os, record.objectives[k] );
+	}
+
+	// ru_maxrss is in kilobytes on Linux
+	os << "],\"peak_rss_kb\":" << usage.ru_maxrss << "}\n";
+
+	std::string line = os.str();
+	lock_guard guard( _lock );
+
+	for ( std::size_t done = 0; done < line.size(); )
+	{
+		ssize_t count = ::write( _fd, line.data() + done, line.size() - done );
+		if ( count < 0 )
+		{
+			if ( errno == EINTR )
+				continue;
+			throw std::runtime_error( "unable to write the trace" );
+		}
+		done += count;
+	}
+}
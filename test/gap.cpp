@@ -0,0 +1,117 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "lower_bound_set.hpp"
+#include "archive.hpp"
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+static const double infinity = std::numeric_limits<double>::infinity();
+static int failures = 0;
+
+/*
+	Function: check
+
+	Report a failed condition.
+*/
+static void check( bool condition, const char * what )
+{
+	if ( !condition )
+	{
+		std::cerr << "FAIL: " << what << std::endl;
+		++failures;
+	}
+}
+
+/*
+	Function: make_front
+
+	Build a bi-objective archive from (z0, z1) pairs.
+*/
+static archive make_front( const double points[][2], int size )
+{
+	archive front( 2 );
+	for ( int index = 0; index < size; ++index )
+	{
+		std::vector<double> z( points[index], points[index] + 2 );
+		front.insert( z );
+	}
+	return front;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int main()
+{
+	// True front {(0,10),(2,6),(5,3),(9,0)}, an epsilon-constraint sweep on
+	// z1 (main objective z0) stopped after the second point
+	static const double found[][2] = { { 0., 10. }, { 2., 6. } };
+	archive front = make_front( found, 2 );
+
+	// Without a nadir bound of z0, the missing points are not bounded
+	{
+		lower_bound_set bounds;
+		bounds.add_epsilon_constraint( 0, -infinity, infinity, 0. );
+		bounds.add_nadir_bound( 1, 10. );
+		bounds.add_epsilon_constraint( 0, -infinity, 9., 2. );
+		bounds.add_epsilon_constraint( 0, -infinity, 5., 3. );
+
+		check( bounds.gap( front ) > 0., "truncated sweep without nadir bound has a gap" );
+		check( bounds.gap( front ) == infinity, "truncated sweep without nadir bound is unbounded" );
+	}
+
+	// With the payoff table of the augmented sweep: min z1 = 0 at z0 = 9
+	{
+		lower_bound_set bounds;
+		bounds.add_epsilon_constraint( 0, -infinity, infinity, 0. );
+		bounds.add_nadir_bound( 1, 10. );
+		bounds.add_weighted_sum( 0, 1., 0. );
+		bounds.add_nadir_bound( 0, 9. );
+		bounds.add_epsilon_constraint( 0, -infinity, 9., 2. );
+		bounds.add_epsilon_constraint( 0, -infinity, 5., 3. );
+
+		check( std::fabs( bounds.gap( front ) - 39. ) < 1e-9, "truncated sweep with payoff table has a gap of 39" );
+	}
+
+	// A complete sweep ends with an infeasible box, which must not make the
+	// gap unbounded once z0 is bounded by the payoff table
+	{
+		static const double all[][2] = { { 0., 10. }, { 2., 6. }, { 5., 3. }, { 9., 0. } };
+		archive complete = make_front( all, 4 );
+
+		lower_bound_set bounds;
+		bounds.add_epsilon_constraint( 0, -infinity, infinity, 0. );
+		bounds.add_nadir_bound( 1, 10. );
+		bounds.add_weighted_sum( 0, 1., 0. );
+		bounds.add_nadir_bound( 0, 9. );
+		bounds.add_epsilon_constraint( 0, -infinity, 9., 2. );
+		bounds.add_epsilon_constraint( 0, -infinity, 5., 5. );
+		bounds.add_epsilon_constraint( 0, -infinity, 2., 9. );
+		bounds.add_epsilon_constraint( 0, -infinity, -1., infinity );
+
+		// only the steps between the points remain: 4 + 3 + 2
+		double gap = bounds.gap( complete );
+		check( gap < infinity, "complete sweep is bounded" );
+		check( std::fabs( gap - 9. ) < 1e-9, "complete sweep has a gap of 9" );
+	}
+
+	if ( failures > 0 )
+		return 1;
+
+	std::cout << "gap: ok" << std::endl;
+	return 0;
+}
@@ -0,0 +1,191 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "problem.hpp"
+#include "flp_solver.hpp"
+#include "argument.hpp"
+#include "archive.hpp"
+#include "methods.hpp"
+#include "reader.hpp"
+#include "budget.hpp"
+#include "checkpoint.hpp"
+#include <iostream>
+#include <limits>
+#include <string>
+#include <algorithm>
+#include <cstdio>
+#include <cmath>
+
+static const char * const instance_file = "instances/F1-2.txt";
+static const char * const checkpoint_file = "test/resume.checkpoint";
+static int failures = 0;
+
+/*
+	Function: check
+
+	Report a failed condition.
+*/
+static void check( bool condition, const std::string & what )
+{
+	if ( !condition )
+	{
+		std::cerr << "FAIL: " << what << std::endl;
+		++failures;
+	}
+}
+
+/*
+	Function: run
+
+	Run a method from scratch, or resume it from the checkpoint.
+
+	Parameters:
+		instance - An instance.
+		method - supported or efficient.
+		state - The checkpoint, 0 to disable.
+		node_limit - The node budget, -1 for none.
+		complete - Set to true if the budget has not been exhausted.
+*/
+static archive run( const problem & instance, const std::string & method, checkpoint * state,
+	long node_limit, bool & complete )
+{
+	budget limits( std::numeric_limits<double>::infinity(), node_limit );
+	flp_solver solve( instance, false );
+	archive pareto_front;
+
+	solve.set_warm_start( true );
+	solve.set_budget( &limits );
+
+	if ( method == "supported" )
+		pareto_front = dichotomic_method( solve, state );
+	else
+		pareto_front = epsilon_constraint( solve, state );
+
+	complete = !limits.exhausted();
+	return pareto_front;
+}
+
+/*
+	Function: same_front
+
+	Compare two fronts point by point.
+*/
+static bool same_front( const archive & a, const archive & b )
+{
+	if ( a.size() != b.size() )
+		return false;
+
+	for ( int index = 0; index < a.size(); ++index )
+	{
+		for ( int k = 0; k < a.dimension(); ++k )
+		{
+			if ( std::fabs( a[index][k] - b[index][k] ) > 1e-6 * std::max( 1., std::fabs( a[index][k] ) ) )
+				return false;
+		}
+	}
+	return true;
+}
+
+/*
+	Function: above_hull
+
+	Return true if no point of a lies strictly below the piecewise linear
+	curve joining the points of b. Supported points on a segment of the hull
+	may or may not be found, only the hull is compared.
+*/
+static bool above_hull( const archive & a, const archive & b )
+{
+	for ( int index = 0; index < a.size(); ++index )
+	{
+		for ( int p = 0; p + 1 < b.size(); ++p )
+		{
+			double s = b[p][0], e = b[p + 1][0], t = a[index][0];
+
+			if ( t < s || t > e || s == e )
+				continue;
+
+			double value = b[p][1] + ( b[p + 1][1] - b[p][1] ) * ( t - s ) / ( e - s );
+			if ( a[index][1] < value - 1e-6 * std::max( 1., std::fabs( value ) ) )
+				return false;
+		}
+	}
+	return true;
+}
+
+/*
+	Function: test_resume
+
+	Stop a method on a small node budget, resume it with a doubled budget
+	until it completes, and compare the front with an uninterrupted run.
+*/
+static void test_resume( const problem & instance, const std::string & method )
+{
+	bool complete = false;
+	archive reference = run( instance, method, 0, -1, complete );
+	archive pareto_front;
+	int stops = 0;
+
+	std::remove( checkpoint_file );
+
+	for ( long node_limit = 1; !complete; node_limit *= 2 )
+	{
+		checkpoint state( checkpoint_file, checkpoint::instance_hash( instance ) + " " + method, 0. );
+		state.load();
+
+		pareto_front = run( instance, method, &state, node_limit, complete );
+
+		if ( !complete )
+			++stops;
+	}
+
+	std::remove( checkpoint_file );
+
+	check( stops > 0, method + ": the node budget stops the run" );
+	if ( method == "supported" )
+		check( same_front( pareto_front, reference )
+			|| ( above_hull( pareto_front, reference ) && above_hull( reference, pareto_front ) ),
+			method + ": the resumed front has the hull of the complete front" );
+	else
+		check( same_front( pareto_front, reference ), method + ": the resumed front is the complete front" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int main()
+{
+	problem instance( true, true );
+	mapped_file file;
+
+	argument::verbose = 0;
+
+	try
+	{
+		load_instance( instance_file, file, instance );
+
+		test_resume( instance, "supported" );
+		test_resume( instance, "efficient" );
+	}
+	catch ( const std::exception & e )
+	{
+		std::cerr << "Error: " << e.what() << std::endl;
+		return 1;
+	}
+
+	if ( failures > 0 )
+		return 1;
+
+	std::cout << "resume: ok" << std::endl;
+	return 0;
+}